@@ -1,11 +1,74 @@
 #include "ActiveClip.h"
 
+#include "FrameStats.h"
 #include "Offsets.h"
 #include "OpenAnimationReplacer.h"
+#include "PoseBlending.h"
 #include "Settings.h"
+#include "UI/UIManager.h"
 
 #include <ranges>
 
+namespace
+{
+	// grow-only buffers for sampling blending clips, reused by every blend on the thread
+	struct BlendScratchBuffers
+	{
+		BlendScratchBuffers()
+		{
+			blendedTracks.reserve(reservedTrackCount);
+			sampledTransformTracks.reserve(reservedTrackCount);
+			sampledFloatTracks.reserve(reservedTrackCount);
+		}
+
+		// enough for the vanilla skeletons
+		static constexpr size_t reservedTrackCount = 256;
+
+		std::vector<RE::hkQsTransform> blendedTracks;
+		std::vector<RE::hkQsTransform> sampledTransformTracks;
+		std::vector<float> sampledFloatTracks;
+		std::array<std::vector<RE::hkQsTransform>, ActiveClip::maxBlendingClips> layerTracks;  // for single pass blending
+	};
+
+	BlendScratchBuffers& GetBlendScratchBuffers()
+	{
+		static thread_local BlendScratchBuffers buffers;
+		return buffers;
+	}
+
+	template <class T>
+	void ResizeScratchBuffer(std::vector<T>& a_buffer, size_t a_size)
+	{
+		if (a_size > a_buffer.capacity()) {
+			++ActiveClip::blendScratchBufferGrowCount;
+		}
+		a_buffer.resize(a_size);
+	}
+
+	// weight of the pose blended so far against the next layer, eased so blends start and end smoothly
+	float GetBlendLerpAmount(float a_blendWeight)
+	{
+		return std::clamp(Utils::InterpEaseInOut(0.f, 1.f, a_blendWeight, 2), 0.f, 1.f);
+	}
+
+	bool SampleBlendingClipTracks(const ActiveClip::BlendingClip& a_blendingClip, std::vector<RE::hkQsTransform>& a_outTracks)
+	{
+		if (const auto binding = a_blendingClip.clipGenerator.animationControl->binding) {
+			if (const auto& blendFromAnimation = binding->animation) {
+				ResizeScratchBuffer(a_outTracks, blendFromAnimation->numberOfTransformTracks);
+				auto& sampledFloatTracks = GetBlendScratchBuffers().sampledFloatTracks;
+				ResizeScratchBuffer(sampledFloatTracks, blendFromAnimation->numberOfFloatTracks);
+
+				blendFromAnimation->SamplePartialTracks(a_blendingClip.clipGenerator.localTime, blendFromAnimation->numberOfTransformTracks, a_outTracks.data(), blendFromAnimation->numberOfFloatTracks, sampledFloatTracks.data(), nullptr);
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
 bool ActiveClip::BlendingClip::Update(const RE::hkbContext& a_context, float a_deltaTime)
 {
 	blendElapsedTime += a_deltaTime;
@@ -30,25 +93,48 @@ ActiveClip::ActiveClip(RE::hkbClipGenerator* a_clipGenerator, RE::hkbCharacter*
 	_bOriginalReplaceOnEcho(OpenAnimationReplacer::GetSingleton().ShouldOriginalAnimationReplaceOnEcho(a_character, a_clipGenerator->animationBindingIndex))
 {
 	_refr = Utils::GetActorFromHkbCharacter(a_character);
+
+	// stagger the first interruptible re-evaluation across actors so they don't all evaluate on the same frame
+	if (Settings::fInterruptibleEvaluationInterval > 0.f && _refr) {
+		const auto stagger = static_cast<float>(std::hash<RE::FormID>{}(_refr->GetFormID()) % 1000) / 1000.f;
+		_timeUntilInterruptibleEvaluation = Settings::fInterruptibleEvaluationInterval * stagger;
+	}
 }
 
 ActiveClip::~ActiveClip()
 {
+	if (!_bDetached) {
+		UnregisterStateDataContainer();
+		RestoreOriginalAnimation();
+	}
+}
+
+void ActiveClip::Detach()
+{
+	if (_bDetached) {
+		return;
+	}
+
 	UnregisterStateDataContainer();
 	RestoreOriginalAnimation();
+	_bDetached = true;
 }
 
 RE::BSEventNotifyControl ActiveClip::ProcessEvent(const RE::BSAnimationGraphEvent* a_event, [[maybe_unused]] RE::BSTEventSource<RE::BSAnimationGraphEvent>* a_eventSource)
 {
-	if (_currentReplacementAnimation && a_event) {
-		if (auto functions = _currentReplacementAnimation->GetFunctionSet(Functions::FunctionSetType::kOnTrigger)) {
-			auto trigger = Functions::Trigger(a_event->tag.data(), a_event->payload.data());
-			functions->ForEach([&](const std::unique_ptr<Functions::IFunction>& a_function) {
-				if (a_function->HasTrigger(a_event->tag.data(), a_event->payload.data())) {
-					a_function->Run(_refr, _clipGenerator, _currentReplacementAnimation->GetParentSubMod(), &trigger);
+	OnConditionDependencyChanged(Utils::ConditionDependency::kAnimationGraph);
+
+	if (_currentReplacementAnimation && a_event && !ShouldSkipTriggerFunctionsForLOD()) {
+		if (const auto functionSet = _currentReplacementAnimation->GetFunctionSet(Functions::FunctionSetType::kOnTrigger)) {
+			// most events have no listeners, reject them before building the trigger
+			if (const auto functions = functionSet->GetFunctionsForEvent(a_event->tag)) {
+				auto trigger = Functions::Trigger(a_event->tag.data(), a_event->payload.data());
+				for (const auto function : *functions) {
+					if (function->HasTrigger(trigger.event, trigger.payload)) {
+						function->Run(_refr, _clipGenerator, _currentReplacementAnimation->GetParentSubMod(), &trigger);
+					}
 				}
-				return RE::BSVisit::BSVisitControl::kContinue;
-			});
+			}
 		}
 	}
 	return RE::BSEventNotifyControl::kContinue;
@@ -134,6 +220,10 @@ void ActiveClip::ReplaceAnimation(ReplacementAnimation* a_replacementAnimation,
 			RegisterEventSink();
 		}
 	}
+
+	if (ShouldTrackAnimationGraphEvents()) {
+		RegisterEventSink();
+	}
 }
 
 void ActiveClip::RestoreOriginalAnimation()
@@ -175,7 +265,8 @@ ReplacementAnimation* ActiveClip::PopQueuedReplacementAnimation()
 
 void ActiveClip::ReplaceActiveAnimation(RE::hkbClipGenerator* a_clipGenerator, const RE::hkbContext& a_context)
 {
-	const float blendTime = _queuedReplacement->blendTime;
+	// a skipped blend swaps instantly, so a loop replacement has to start at the beginning too
+	const float blendTime = ShouldSkipBlendingForLOD() ? 0.f : _queuedReplacement->blendTime;
 	const auto replacementEvent = _queuedReplacement->replacementEvent;
 	const auto type = _queuedReplacement->type;
 
@@ -261,7 +352,14 @@ void ActiveClip::SetTransitioning(bool a_bValue, TransitioningReason a_transitio
 
 void ActiveClip::StartBlend(RE::hkbClipGenerator* a_clipGenerator, const RE::hkbContext& a_context, float a_blendTime)
 {
-	const auto& newBlendingClip = _blendingClipGenerators.emplace_back(std::make_unique<BlendingClip>(a_clipGenerator, a_blendTime));
+	// make room by dropping the oldest layers, they contribute the least
+	const size_t maxLayers = std::clamp<size_t>(Settings::uMaxBlendLayers, 1, maxBlendingClips);
+	while (_blendingClipGenerators.size() >= maxLayers) {
+		_blendingClipGenerators.erase(_blendingClipGenerators.begin());
+		++culledBlendingClipCount;
+	}
+
+	const auto& newBlendingClip = _blendingClipGenerators.emplace_back(MakePooled<BlendingClip>(a_clipGenerator, a_blendTime));
 
 	_lastGameTime = OpenAnimationReplacer::gameTimeCounter;
 
@@ -274,21 +372,30 @@ void ActiveClip::PreUpdate(RE::hkbClipGenerator* a_clipGenerator, const RE::hkbC
 		return;  // Analogous function already ran by ActiveSynchronizedAnimation
 	}
 
+	UpdateLODTier();
+
 	bool bIsLoopingThisUpdate = false;
+	bool bIsNearLoop = false;
 	if (a_clipGenerator->mode == RE::hkbClipGenerator::PlaybackMode::kModeLooping) {
-		float prevLocalTime = 0.f;
-		float newLocalTime = 0.f;
-		int32_t numLoops = 0;
-		bool newAtEnd = false;
-
-		hkbClipGenerator_ComputeBeginAndEndLocalTime(a_clipGenerator, a_timestep, &prevLocalTime, &newLocalTime, &numLoops, &newAtEnd);
-
-		bIsLoopingThisUpdate = numLoops > 0;
+		bIsNearLoop = !IsFarFromLoop(a_clipGenerator, a_timestep);
+		if (bIsNearLoop) {
+			float prevLocalTime = 0.f;
+			float newLocalTime = 0.f;
+			int32_t numLoops = 0;
+			bool newAtEnd = false;
+
+			hkbClipGenerator_ComputeBeginAndEndLocalTime(a_clipGenerator, a_timestep, &prevLocalTime, &newLocalTime, &numLoops, &newAtEnd);
+
+			bIsLoopingThisUpdate = numLoops > 0;
+			if (bIsLoopingThisUpdate) {
+				_loopLookahead.bValid = false;
+			}
+		}
 	}
 
 	if (!IsReadyToReplace(bIsLoopingThisUpdate)) {
 		// check if the animation should be interrupted (queue a replacement if so)
-		if (IsInterruptible()) {
+		if (IsInterruptible() && ShouldEvaluateInterruptible(a_timestep)) {
 			const auto newReplacementAnim = OpenAnimationReplacer::GetSingleton().GetReplacementAnimation(a_context.character, a_clipGenerator, _originalIndex);
 			// do not try to replace with other variants here
 			Variant* dummy = nullptr;
@@ -306,21 +413,9 @@ void ActiveClip::PreUpdate(RE::hkbClipGenerator* a_clipGenerator, const RE::hkbC
 		// check if the animation is going to loop in this update
 		if (a_clipGenerator->mode == RE::hkbClipGenerator::PlaybackMode::kModeLooping) {
 			bool bIsLoopingThisUpdateWithBlendTimeOffset = bIsLoopingThisUpdate;
-			if (!bIsLoopingThisUpdate) {
+			if (!bIsLoopingThisUpdate && bIsNearLoop) {
 				// calculate numLoops in this update, with added blend time so we replace just before it loops
-				float blendTime = Settings::fDefaultBlendTimeOnLoop;
-				if (HasReplacementAnimation()) {
-					blendTime = GetReplacementAnimation()->GetCustomBlendTime(this, CustomBlendType::kLoop, true);
-				}
-
-				if (hkbClipGenerator_GetAnimDuration(a_clipGenerator) <= blendTime) {
-					blendTime = 0.f;
-				}
-
-				if (a_clipGenerator->animationControl->playbackSpeed > 0.f) {
-					blendTime /= a_clipGenerator->animationControl->playbackSpeed;
-				}
-
+				const float blendTime = GetLoopBlendTime(a_clipGenerator);
 				if (blendTime > 0.f) {
 					float prevLocalTime = 0.f;
 					float newLocalTime = 0.f;
@@ -381,6 +476,8 @@ void ActiveClip::PreUpdate(RE::hkbClipGenerator* a_clipGenerator, const RE::hkbC
 				++it;
 			}
 		}
+
+		CullNegligibleBlendingClips();
 	}
 }
 
@@ -406,6 +503,8 @@ void ActiveClip::OnActivate(RE::hkbClipGenerator* a_clipGenerator, const RE::hkb
 				if (_currentReplacementAnimation && _currentReplacementAnimation->GetTriggersFromAnnotationsOnly()) {
 					BackupTriggers(a_clipGenerator);
 				}
+			} else if (ShouldTrackAnimationGraphEvents()) {
+				RegisterEventSink();
 			}
 		}
 	}
@@ -509,10 +608,15 @@ void ActiveClip::OnGenerate([[maybe_unused]] RE::hkbClipGenerator* a_clipGenerat
 		RE::hkbGeneratorOutput::Track poseTrack = a_output.GetTrack(RE::hkbGeneratorOutput::StandardTracks::TRACK_POSE);
 
 		auto poseOut = poseTrack.GetDataQsTransform();
+		const float lerpAmount = GetBlendLerpAmount(GetBlendWeight());
+
+		if (Settings::bSinglePassPoseBlending) {
+			BlendPoseInOnePass(poseOut, static_cast<uint32_t>(poseTrack.GetNumData()), lerpAmount);
+			return;
+		}
 
-		std::vector<RE::hkQsTransform> blendedTracks{};
+		auto& blendedTracks = GetBlendScratchBuffers().blendedTracks;
 		if (GetBlendedTracks(blendedTracks)) {
-			float lerpAmount = std::clamp(Utils::InterpEaseInOut(0.f, 1.f, GetBlendWeight(), 2), 0.f, 1.f);
 			auto numBlend = std::min(static_cast<size_t>(poseTrack.GetNumData()), blendedTracks.size());
 			hkbBlendPoses(numBlend, poseOut, blendedTracks.data(), lerpAmount, poseOut);
 		}
@@ -692,32 +796,16 @@ bool ActiveClip::GetBlendedTracks(std::vector<RE::hkQsTransform>& a_outBlendedTr
 		return false;
 	}
 
-	auto getTracks = [](const auto& a_blendingClip, std::vector<RE::hkQsTransform>& a_sampledTracks) {
-		if (const auto binding = a_blendingClip->clipGenerator.animationControl->binding) {
-			if (const auto& blendFromAnimation = binding->animation) {
-				a_sampledTracks.resize(blendFromAnimation->numberOfTransformTracks);
-				std::vector<float> sampledFloatTracks{};
-				sampledFloatTracks.resize(blendFromAnimation->numberOfFloatTracks);
-
-				blendFromAnimation->SamplePartialTracks(a_blendingClip->clipGenerator.localTime, blendFromAnimation->numberOfTransformTracks, a_sampledTracks.data(), blendFromAnimation->numberOfFloatTracks, sampledFloatTracks.data(), nullptr);
-
-				return true;
-			}
-		}
-
-		return false;
-	};
-
 	if (_blendingClipGenerators.size() == 1) {
 		const auto& blendingClip = _blendingClipGenerators.front();
-		return getTracks(blendingClip, a_outBlendedTracks);
+		return SampleBlendingClipTracks(*blendingClip, a_outBlendedTracks);
 	}
 
 	// get tracks from the first blending clip
 	auto it = _blendingClipGenerators.begin();
 	const auto& firstClip = *it;
 	float blendWeight = firstClip->GetBlendWeight();
-	if (!getTracks(*it, a_outBlendedTracks)) {
+	if (!SampleBlendingClipTracks(*firstClip, a_outBlendedTracks)) {
 		return false;
 	}
 	++it;
@@ -725,9 +813,9 @@ bool ActiveClip::GetBlendedTracks(std::vector<RE::hkQsTransform>& a_outBlendedTr
 	// blend with the rest
 	while (it != _blendingClipGenerators.end()) {
 		const auto& blendingClip = *it;
-		std::vector<RE::hkQsTransform> sampledTransformTracks{};
-		if (getTracks(blendingClip, sampledTransformTracks)) {
-			const float lerpAmount = std::clamp(Utils::InterpEaseInOut(0.f, 1.f, blendWeight, 2), 0.f, 1.f);
+		auto& sampledTransformTracks = GetBlendScratchBuffers().sampledTransformTracks;
+		if (SampleBlendingClipTracks(*blendingClip, sampledTransformTracks)) {
+			const float lerpAmount = GetBlendLerpAmount(blendWeight);
 
 			auto numBlend = std::min(a_outBlendedTracks.size(), static_cast<size_t>(blendingClip->clipGenerator.animationControl->binding->animation->numberOfTransformTracks));
 			hkbBlendPoses(numBlend, sampledTransformTracks.data(), a_outBlendedTracks.data(), lerpAmount, a_outBlendedTracks.data());
@@ -740,6 +828,202 @@ bool ActiveClip::GetBlendedTracks(std::vector<RE::hkQsTransform>& a_outBlendedTr
 	return true;
 }
 
+void ActiveClip::BlendPoseInOnePass(RE::hkQsTransform* a_pose, uint32_t a_numTracks, float a_lerpAmount)
+{
+	auto& scratchBuffers = GetBlendScratchBuffers();
+
+	// same weights as GetBlendedTracks, each layer is weighted by the blend weight of the previous one and the output pose comes last
+	std::array<PoseBlending::Layer, maxBlendingClips + 1> layers;
+	size_t numLayers = 0;
+	float blendWeight = 0.f;
+
+	size_t clipIndex = 0;
+	for (const auto& blendingClip : _blendingClipGenerators) {
+		auto& tracks = scratchBuffers.layerTracks[clipIndex++];
+		if (!SampleBlendingClipTracks(*blendingClip, tracks)) {
+			if (numLayers == 0) {
+				return;
+			}
+			continue;
+		}
+
+		const float lerpAmount = GetBlendLerpAmount(blendWeight);
+		layers[numLayers++] = { tracks.data(), static_cast<uint32_t>(tracks.size()), lerpAmount };
+		blendWeight = blendingClip->GetBlendWeight();
+	}
+
+	layers[numLayers++] = { a_pose, a_numTracks, a_lerpAmount };
+
+	PoseBlending::BlendLayers({ layers.data(), numLayers }, a_pose, a_numTracks);
+}
+
+void ActiveClip::CullNegligibleBlendingClips()
+{
+	if (Settings::fBlendLayerCullWeight <= 0.f) {
+		return;
+	}
+
+	// the oldest layer ends up scaled by the lerp amount of every layer after it and of the final blend with the output pose, so it's the first to become negligible
+	while (!_blendingClipGenerators.empty()) {
+		float effectiveWeight = 1.f;
+		for (const auto& blendingClip : _blendingClipGenerators) {
+			effectiveWeight *= GetBlendLerpAmount(blendingClip->GetBlendWeight());
+		}
+
+		if (effectiveWeight >= Settings::fBlendLayerCullWeight) {
+			break;
+		}
+
+		_blendingClipGenerators.erase(_blendingClipGenerators.begin());
+		++culledBlendingClipCount;
+	}
+}
+
+float ActiveClip::GetLoopBlendTime(RE::hkbClipGenerator* a_clipGenerator)
+{
+	float blendTime = Settings::fDefaultBlendTimeOnLoop;
+	if (HasReplacementAnimation()) {
+		blendTime = GetReplacementAnimation()->GetCustomBlendTime(this, CustomBlendType::kLoop, true);
+	}
+
+	if (hkbClipGenerator_GetAnimDuration(a_clipGenerator) <= blendTime) {
+		blendTime = 0.f;
+	}
+
+	if (a_clipGenerator->animationControl->playbackSpeed > 0.f) {
+		blendTime /= a_clipGenerator->animationControl->playbackSpeed;
+	}
+
+	return blendTime;
+}
+
+bool ActiveClip::IsFarFromLoop(RE::hkbClipGenerator* a_clipGenerator, float a_timestep)
+{
+	const float playbackSpeed = a_clipGenerator->animationControl->playbackSpeed;
+
+	// the estimate only handles forward playback at the animation's own length
+	if (playbackSpeed <= 0.f || a_clipGenerator->enforcedDuration > 0.f) {
+		_loopLookahead.bValid = false;
+		return false;
+	}
+
+	if (!_loopLookahead.bValid || _loopLookahead.playbackSpeed != playbackSpeed || _loopLookahead.animationBindingIndex != a_clipGenerator->animationBindingIndex || _loopLookahead.replacementAnimation != _currentReplacementAnimation) {
+		// subtracting both crops errs on the early side whichever way havok offsets the local time
+		_loopLookahead.loopEndLocalTime = hkbClipGenerator_GetAnimDuration(a_clipGenerator) - a_clipGenerator->cropStartAmountLocalTime - a_clipGenerator->cropEndAmountLocalTime;
+		_loopLookahead.blendTime = GetLoopBlendTime(a_clipGenerator);
+		_loopLookahead.playbackSpeed = playbackSpeed;
+		_loopLookahead.animationBindingIndex = a_clipGenerator->animationBindingIndex;
+		_loopLookahead.replacementAnimation = _currentReplacementAnimation;
+		_loopLookahead.bValid = true;
+	}
+
+	// read from the clip's local time every update, so anything else moving it can't make the estimate drift
+	const float timeUntilLoop = (_loopLookahead.loopEndLocalTime - a_clipGenerator->localTime) / playbackSpeed;
+
+	return timeUntilLoop - a_timestep - _loopLookahead.blendTime > loopLookaheadMargin;
+}
+
+float ActiveClip::GetInterruptibleEvaluationInterval() const
+{
+	float interval = Settings::fInterruptibleEvaluationInterval;
+
+	if (interval > 0.f && Settings::bScaleInterruptibleEvaluationIntervalWithDistance && Settings::fInterruptibleEvaluationDistanceStep > 0.f) {
+		interval *= 1.f + _cameraDistance / Settings::fInterruptibleEvaluationDistanceStep;
+		interval = std::min(interval, std::max(Settings::fInterruptibleEvaluationMaxInterval, Settings::fInterruptibleEvaluationInterval));
+	}
+
+	return std::max(interval, GetLODEvaluationInterval());
+}
+
+void ActiveClip::UpdateLODTier()
+{
+	// measured once per update, the interruptible evaluation interval reuses it
+	const bool bScaleIntervalWithDistance = Settings::bScaleInterruptibleEvaluationIntervalWithDistance && Settings::fInterruptibleEvaluationDistanceStep > 0.f;
+	if (Settings::bEnableDistanceLOD || bScaleIntervalWithDistance) {
+		_cameraDistance = Utils::GetDistanceToCamera(_refr);
+	}
+
+	LODTier tier = LODTier::kNear;
+
+	if (Settings::bEnableDistanceLOD) {
+		if (_cameraDistance >= Settings::fLODFarDistance) {
+			tier = LODTier::kFar;
+		} else if (_cameraDistance >= Settings::fLODMidDistance) {
+			tier = LODTier::kMid;
+		}
+	}
+
+	_lodTier.store(tier, std::memory_order_relaxed);
+}
+
+float ActiveClip::GetLODEvaluationInterval() const
+{
+	switch (GetLODTier()) {
+	case LODTier::kMid:
+		return Settings::fLODMidEvaluationInterval;
+	case LODTier::kFar:
+		return Settings::fLODFarEvaluationInterval;
+	default:
+		return 0.f;
+	}
+}
+
+bool ActiveClip::ShouldSkipBlendingForLOD() const
+{
+	switch (GetLODTier()) {
+	case LODTier::kMid:
+		return Settings::bLODMidSkipBlending;
+	case LODTier::kFar:
+		return Settings::bLODFarSkipBlending;
+	default:
+		return false;
+	}
+}
+
+bool ActiveClip::ShouldSkipTriggerFunctionsForLOD() const
+{
+	switch (GetLODTier()) {
+	case LODTier::kMid:
+		return Settings::bLODMidSkipTriggerFunctions;
+	case LODTier::kFar:
+		return Settings::bLODFarSkipTriggerFunctions;
+	default:
+		return false;
+	}
+}
+
+bool ActiveClip::ShouldEvaluateInterruptible(float a_timestep)
+{
+	if (const float interval = GetInterruptibleEvaluationInterval(); interval > 0.f) {
+		_timeUntilInterruptibleEvaluation -= a_timestep;
+		if (_timeUntilInterruptibleEvaluation > 0.f) {
+			return false;
+		}
+
+		// keep the leftover so the stagger between actors is preserved
+		_timeUntilInterruptibleEvaluation = std::max(_timeUntilInterruptibleEvaluation + interval, 0.f);
+	}
+
+	// skip if none of the inputs the conditions depend on have changed since the last evaluation. Conditions might be edited while the UI is open, so don't skip then
+	if (Settings::bTrackConditionDependencies && _replacements && !UI::UIManager::GetSingleton().bShowMain) {
+		const auto changedDependencies = _changedConditionDependencies.exchange(0);
+		const auto dependencies = _replacements->GetConditionDependencies();
+		if (dependencies.none(Utils::ConditionDependency::kUnknown) && (dependencies.underlying() & changedDependencies) == 0) {
+			++OpenAnimationReplacer::skippedInterruptibleEvaluationCount;
+			return false;
+		}
+	}
+
+	++OpenAnimationReplacer::interruptibleEvaluationCount;
+	FrameStats::GetSingleton().Increment(FrameStats::Counter::kInterruptibleEvaluations);
+	return true;
+}
+
+bool ActiveClip::ShouldTrackAnimationGraphEvents() const
+{
+	return Settings::bTrackConditionDependencies && _replacements && IsInterruptible() && _replacements->GetConditionDependencies().any(Utils::ConditionDependency::kAnimationGraph);
+}
+
 float ActiveClip::GetBlendWeight() const
 {
 	if (_blendingClipGenerators.empty()) {
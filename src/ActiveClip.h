@@ -3,6 +3,7 @@
 #include "AnimationLog.h"
 #include "Containers.h"
 #include "FakeClipGenerator.h"
+#include "ObjectPool.h"
 #include "ReplacementAnimation.h"
 
 // a core class of OAR - holds additional data and logic about an active clip generator, created when a clip generator is activated and destroyed when it is deactivated
@@ -56,6 +57,8 @@ public:
 		float blendElapsedTime = 0.f;
 	};
 
+	static constexpr size_t maxBlendingClips = 8;  // interrupting more often than this within a blend drops the oldest one
+
 	enum class TransitioningReason
 	{
 		kDefault,
@@ -63,6 +66,16 @@ public:
 		kVariantLoop
 	};
 
+	// distance to the camera based level of detail, see the LOD settings for what each tier skips
+	enum class LODTier : uint8_t
+	{
+		kNear,
+		kMid,
+		kFar,
+
+		kTotal
+	};
+
 	std::shared_ptr<ActiveClip> getptr()
 	{
 		return shared_from_this();
@@ -82,6 +95,8 @@ public:
 	bool ShouldReplaceAnimation(const ReplacementAnimation* a_newReplacementAnimation, bool a_bTryVariant, Variant*& a_outVariant);
 	void ReplaceAnimation(ReplacementAnimation* a_replacementAnimation, Variant*& a_variant);
 	void RestoreOriginalAnimation();
+	// hands the clip generator back right away when the clip is removed, the object itself is only freed a few frames later
+	void Detach();
 	void QueueReplacementAnimation(ReplacementAnimation* a_replacementAnimation, float a_blendTime, QueuedReplacement::Type a_type, AnimationLogEntry::Event a_replacementEvent, Variant* a_variant = nullptr, bool a_bReplaceAtTrueEndOfLoop = false);
 	[[nodiscard]] ReplacementAnimation* PopQueuedReplacementAnimation();
 	void ReplaceActiveAnimation(RE::hkbClipGenerator* a_clipGenerator, const RE::hkbContext& a_context);
@@ -104,6 +119,7 @@ public:
 	[[nodiscard]] bool IsSynchronizedClip() const { return _parentSynchronizedClipGenerator != nullptr; }
 	[[nodiscard]] RE::BSSynchronizedClipGenerator* GetParentSynchronizedClipGenerator() const { return _parentSynchronizedClipGenerator; }
 	[[nodiscard]] bool HasRemovedNonAnnotationTriggers() const { return _bRemovedNonAnnotationTriggers; }
+	[[nodiscard]] LODTier GetLODTier() const { return _lodTier.load(std::memory_order_relaxed); }
 
 	// interruptible anim
 	[[nodiscard]] bool IsInterruptible() const { return _currentReplacementAnimation ? _currentReplacementAnimation->GetInterruptible() : _bOriginalInterruptible; }
@@ -134,6 +150,8 @@ public:
 	void RegisterEventSink();
 	void UnregisterEventSink();
 
+	void OnConditionDependencyChanged(Utils::ConditionDependency a_dependency) { _changedConditionDependencies.fetch_or(static_cast<uint32_t>(a_dependency)); }
+
 	[[nodiscard]] bool ShouldRunFunctionsOnLoop() const { return _currentReplacementAnimation ? _currentReplacementAnimation->GetRunFunctionsOnLoop() : false; }
 	[[nodiscard]] bool ShouldRunFunctionsOnEcho() const { return _currentReplacementAnimation ? _currentReplacementAnimation->GetRunFunctionsOnEcho() : false; }
 
@@ -141,11 +159,26 @@ public:
 
 	ReplacementTrace trace;
 
+	// times a blend sampling scratch buffer had to grow, stays flat once every thread has seen the largest skeleton
+	static inline std::atomic_uint64_t blendScratchBufferGrowCount = 0;
+	static inline std::atomic_uint64_t culledBlendingClipCount = 0;
+
 protected:
 	bool OnLoopOrEcho(RE::hkbClipGenerator* a_clipGenerator, bool a_bIsEcho, float a_echoDuration = 0.f);
 	void RemoveNonAnnotationTriggersFromClipTriggerArray(RE::hkRefPtr<RE::hkbClipTriggerArray>& a_clipTriggerArray);
 	bool GetBlendedTracks(std::vector<RE::hkQsTransform>& a_outBlendedTracks);
+	void BlendPoseInOnePass(RE::hkQsTransform* a_pose, uint32_t a_numTracks, float a_lerpAmount);
+	void CullNegligibleBlendingClips();
 	float GetBlendWeight() const;
+	[[nodiscard]] float GetLoopBlendTime(RE::hkbClipGenerator* a_clipGenerator);
+	[[nodiscard]] bool IsFarFromLoop(RE::hkbClipGenerator* a_clipGenerator, float a_timestep);
+	[[nodiscard]] float GetInterruptibleEvaluationInterval() const;
+	void UpdateLODTier();
+	[[nodiscard]] float GetLODEvaluationInterval() const;
+	[[nodiscard]] bool ShouldSkipBlendingForLOD() const;
+	[[nodiscard]] bool ShouldSkipTriggerFunctionsForLOD() const;
+	[[nodiscard]] bool ShouldEvaluateInterruptible(float a_timestep);
+	[[nodiscard]] bool ShouldTrackAnimationGraphEvents() const;
 
 	AnimationReplacements* _replacements = nullptr;
 	ReplacementAnimation* _currentReplacementAnimation = nullptr;
@@ -166,16 +199,38 @@ protected:
 	bool _bRemovedNonAnnotationTriggers = false;
 	bool _bIsAtEndOfLoop = false;
 	bool _bLogAtEndOfLoop = false;
+
+	// loop lookahead, refreshed once per loop cycle so the exact havok computation only runs close to the loop
+	struct LoopLookahead
+	{
+		float loopEndLocalTime = 0.f;
+		float blendTime = 0.f;
+		float playbackSpeed = 0.f;
+		uint16_t animationBindingIndex = 0;
+		const ReplacementAnimation* replacementAnimation = nullptr;
+		bool bValid = false;
+	};
+
+	static constexpr float loopLookaheadMargin = 0.1f;  // seconds before the estimated loop when the exact computation takes over again
+	LoopLookahead _loopLookahead;
 	const bool _bOriginalInterruptible;
 	const bool _bOriginalReplaceOnEcho;
 
+	// interruptible re-evaluation throttling
+	float _timeUntilInterruptibleEvaluation = 0.f;
+	std::atomic<uint32_t> _changedConditionDependencies = 0;
+
+	std::atomic<LODTier> _lodTier = LODTier::kNear;
+	float _cameraDistance = 0.f;  // updated with the lod tier at the start of each update
+
 	bool _bTransitioning = false;
 	TransitioningReason _transitioningReason = TransitioningReason::kDefault;
 	RE::BSSynchronizedClipGenerator* _parentSynchronizedClipGenerator = nullptr;
 
 	// interruptible anim blending
 	float _lastGameTime = 0.f;
-	std::deque<std::unique_ptr<BlendingClip>> _blendingClipGenerators{};
+	BoundedVector<PoolPtr<BlendingClip>, maxBlendingClips> _blendingClipGenerators{};
 
 	bool _bRegisteredSink = false;
+	bool _bDetached = false;
 };
@@ -0,0 +1,101 @@
+#include "ActiveEffectSnapshot.h"
+
+#include "Offsets.h"
+
+bool ActiveEffectSnapshot::HasEffect(RE::FormID a_effectID) const
+{
+	return !GetEffects(a_effectID).empty();
+}
+
+bool ActiveEffectSnapshot::HasKeyword(RE::FormID a_keywordID) const
+{
+	return std::ranges::binary_search(keywords, a_keywordID);
+}
+
+std::span<const std::pair<RE::FormID, float>> ActiveEffectSnapshot::GetEffects(RE::FormID a_effectID) const
+{
+	const auto [first, last] = std::ranges::equal_range(effects, a_effectID, {}, &std::pair<RE::FormID, float>::first);
+
+	return { first, last };
+}
+
+std::shared_ptr<const ActiveEffectSnapshot> ActiveEffectSnapshots::Get(RE::Actor* a_actor)
+{
+	if (!a_actor) {
+		return nullptr;
+	}
+
+	const Utils::RefrKey key(a_actor);
+	const uint32_t frame = g_durationOfApplicationRunTimeMS;
+
+	{
+		ReadLocker locker(_lock);
+
+		if (_frame == frame) {
+			if (const auto it = _snapshots.find(key); it != _snapshots.end()) {
+				return it->second;
+			}
+		}
+	}
+
+	auto snapshot = Build(a_actor);
+
+	WriteLocker locker(_lock);
+
+	// snapshots from previous frames are outdated
+	if (_frame != frame) {
+		_frame = frame;
+		_snapshots.clear();
+	}
+
+	return _snapshots.try_emplace(key, std::move(snapshot)).first->second;
+}
+
+void ActiveEffectSnapshots::Invalidate(RE::TESObjectREFR* a_refr)
+{
+	if (!a_refr) {
+		return;
+	}
+
+	WriteLocker locker(_lock);
+
+	_snapshots.erase(Utils::RefrKey(a_refr));
+}
+
+std::shared_ptr<const ActiveEffectSnapshot> ActiveEffectSnapshots::Build(RE::Actor* a_actor)
+{
+	auto snapshot = std::make_shared<ActiveEffectSnapshot>();
+
+	const auto addEffect = [&](RE::ActiveEffect* a_activeEffect) {
+		if (a_activeEffect && !a_activeEffect->flags.any(RE::ActiveEffect::Flag::kInactive)) {
+			if (const auto baseEffect = a_activeEffect->GetBaseObject()) {
+				snapshot->effects.emplace_back(baseEffect->GetFormID(), a_activeEffect->elapsedSeconds);
+				for (uint32_t i = 0; i < baseEffect->numKeywords; ++i) {
+					if (const auto keyword = baseEffect->keywords[i]) {
+						snapshot->keywords.emplace_back(keyword->GetFormID());
+					}
+				}
+			}
+		}
+	};
+
+	const auto magicTarget = a_actor->AsMagicTarget();
+	if (REL::Module::IsVR()) {  // VR must use a visitor since it doesn't have GetActiveEffectList
+		magicTarget->VisitActiveEffects([&](RE::ActiveEffect* a_activeEffect) {
+			addEffect(a_activeEffect);
+			return RE::BSContainer::ForEachResult::kContinue;
+		});
+	} else if (const auto activeEffects = magicTarget->GetActiveEffectList()) {
+		for (const auto activeEffect : *activeEffects) {
+			addEffect(activeEffect);
+		}
+	}
+
+	// stable so effects with the same ID keep the order of the effect list
+	std::ranges::stable_sort(snapshot->effects, {}, &std::pair<RE::FormID, float>::first);
+	std::ranges::sort(snapshot->keywords);
+	const auto [first, last] = std::ranges::unique(snapshot->keywords);
+	snapshot->keywords.erase(first, last);
+
+	return snapshot;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Utils.h"
+
+// summary of the active (not inactive) magic effects on an actor, sorted so the magic effect conditions can use a binary search instead of walking the effect list
+struct ActiveEffectSnapshot
+{
+	[[nodiscard]] bool HasEffect(RE::FormID a_effectID) const;
+	[[nodiscard]] bool HasKeyword(RE::FormID a_keywordID) const;
+	[[nodiscard]] std::span<const std::pair<RE::FormID, float>> GetEffects(RE::FormID a_effectID) const;
+
+	std::vector<std::pair<RE::FormID, float>> effects;  // base effect ID and elapsed seconds of each active effect, sorted by ID
+	std::vector<RE::FormID> keywords;                    // union of the keywords of all active base effects, sorted
+};
+
+// builds the snapshot of an actor at most once per frame, the first time a condition asks for it
+class ActiveEffectSnapshots final
+{
+public:
+	static ActiveEffectSnapshots& GetSingleton()
+	{
+		static ActiveEffectSnapshots singleton;
+		return singleton;
+	}
+
+	[[nodiscard]] std::shared_ptr<const ActiveEffectSnapshot> Get(RE::Actor* a_actor);
+	void Invalidate(RE::TESObjectREFR* a_refr);
+
+private:
+	ActiveEffectSnapshots() = default;
+	ActiveEffectSnapshots(const ActiveEffectSnapshots&) = delete;
+	ActiveEffectSnapshots(ActiveEffectSnapshots&&) = delete;
+	~ActiveEffectSnapshots() = default;
+
+	ActiveEffectSnapshots& operator=(const ActiveEffectSnapshots&) = delete;
+	ActiveEffectSnapshots& operator=(ActiveEffectSnapshots&&) = delete;
+
+	[[nodiscard]] static std::shared_ptr<const ActiveEffectSnapshot> Build(RE::Actor* a_actor);
+
+	mutable SharedLock _lock;
+	uint32_t _frame = 0;
+	std::unordered_map<Utils::RefrKey, std::shared_ptr<const ActiveEffectSnapshot>, Utils::RefrKey::Hash> _snapshots;
+};
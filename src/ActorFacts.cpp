@@ -0,0 +1,236 @@
+#include "ActorFacts.h"
+
+#include "Offsets.h"
+#include "Settings.h"
+
+namespace
+{
+	// each thread only writes its own counters, so they don't need atomic read-modify-writes
+	struct FactCounters
+	{
+		std::array<std::atomic<uint64_t>, ActorFacts::factCount> hits{};
+		std::array<std::atomic<uint64_t>, ActorFacts::factCount> misses{};
+	};
+
+	ExclusiveLock factCountersLock;
+	std::vector<std::unique_ptr<FactCounters>> allFactCounters;
+
+	FactCounters& GetThreadFactCounters()
+	{
+		static thread_local FactCounters* threadCounters = nullptr;
+
+		if (!threadCounters) {
+			// only taken once per thread. The counters outlive the thread, so the totals stay correct
+			Locker locker(factCountersLock);
+			threadCounters = allFactCounters.emplace_back(std::make_unique<FactCounters>()).get();
+		}
+
+		return *threadCounters;
+	}
+
+	void IncrementCounter(std::atomic<uint64_t>& a_counter)
+	{
+		a_counter.store(a_counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	uint64_t SumCounters(std::array<std::atomic<uint64_t>, ActorFacts::factCount> FactCounters::*a_counters, size_t a_index)
+	{
+		Locker locker(factCountersLock);
+
+		uint64_t total = 0;
+		for (const auto& counters : allFactCounters) {
+			total += ((*counters).*a_counters)[a_index].load(std::memory_order_relaxed);
+		}
+
+		return total;
+	}
+}
+
+uint32_t ActorFacts::Get(Fact a_fact, RE::Actor* a_actor)
+{
+	const auto index = static_cast<size_t>(a_fact);
+	const uint32_t bit = 1u << index;
+
+	if (_filled.load(std::memory_order_acquire) & bit) {
+		IncrementCounter(GetThreadFactCounters().hits[index]);
+		return _values[index].load(std::memory_order_relaxed);
+	}
+
+	// two threads asking at once may both compute the fact, which is harmless
+	IncrementCounter(GetThreadFactCounters().misses[index]);
+	const uint32_t value = Compute(a_fact, a_actor);
+	_values[index].store(value, std::memory_order_relaxed);
+	_filled.fetch_or(bit, std::memory_order_release);
+
+	return value;
+}
+
+uint32_t ActorFacts::Compute(Fact a_fact, RE::Actor* a_actor)
+{
+	switch (a_fact) {
+	case Fact::kIsFemale:
+		{
+			const auto tesNPC = a_actor->GetActorBase();
+			return tesNPC && tesNPC->IsFemale();
+		}
+	case Fact::kLevel:
+		return a_actor->GetLevel();
+	case Fact::kIsInCombat:
+		return a_actor->IsInCombat();
+	case Fact::kIsWeaponDrawn:
+		return a_actor->AsActorState()->IsWeaponDrawn();
+	case Fact::kIsSneaking:
+		return a_actor->IsSneaking();
+	case Fact::kIsSprinting:
+		return a_actor->AsActorState()->IsSprinting();
+	case Fact::kIsInMidair:
+		return a_actor->IsInMidair();
+	case Fact::kIsOnMount:
+		return a_actor->IsOnMount();
+	case Fact::kIsOnStairs:
+		if (const auto charController = a_actor->GetCharController()) {
+			return charController->flags.any(RE::CHARACTER_FLAGS::kOnStairs);
+		}
+		return false;
+	case Fact::kLightLevel:
+		return std::bit_cast<uint32_t>(Actor_GetLightLevel(a_actor));
+	case Fact::kSurfaceMaterial:
+		if (const auto charController = a_actor->GetCharController()) {
+			return static_cast<uint32_t>(*SKSE::stl::adjust_pointer<RE::MATERIAL_ID>(charController, 0x304));
+		}
+		return noSurfaceMaterial;
+	}
+
+	return 0;
+}
+
+std::string_view ActorFacts::GetFactName(Fact a_fact)
+{
+	switch (a_fact) {
+	case Fact::kIsFemale:
+		return "Is female"sv;
+	case Fact::kLevel:
+		return "Level"sv;
+	case Fact::kIsInCombat:
+		return "Is in combat"sv;
+	case Fact::kIsWeaponDrawn:
+		return "Is weapon drawn"sv;
+	case Fact::kIsSneaking:
+		return "Is sneaking"sv;
+	case Fact::kIsSprinting:
+		return "Is sprinting"sv;
+	case Fact::kIsInMidair:
+		return "Is in air"sv;
+	case Fact::kIsOnMount:
+		return "Is on mount"sv;
+	case Fact::kIsOnStairs:
+		return "Is on stairs"sv;
+	case Fact::kLightLevel:
+		return "Light level"sv;
+	case Fact::kSurfaceMaterial:
+		return "Surface material"sv;
+	}
+
+	return ""sv;
+}
+
+uint64_t ActorFacts::GetHitCount(Fact a_fact)
+{
+	return SumCounters(&FactCounters::hits, static_cast<size_t>(a_fact));
+}
+
+uint64_t ActorFacts::GetMissCount(Fact a_fact)
+{
+	return SumCounters(&FactCounters::misses, static_cast<size_t>(a_fact));
+}
+
+bool ActorFactCache::GetSurfaceMaterial(RE::Actor* a_actor, RE::MATERIAL_ID& a_outMaterialID)
+{
+	const uint32_t materialID = GetFact(a_actor, ActorFacts::Fact::kSurfaceMaterial);
+	if (materialID == ActorFacts::noSurfaceMaterial) {
+		return false;
+	}
+
+	a_outMaterialID = static_cast<RE::MATERIAL_ID>(materialID);
+	return true;
+}
+
+void ActorFactCache::Invalidate(RE::TESObjectREFR* a_refr)
+{
+	if (!a_refr) {
+		return;
+	}
+
+	ReadLocker locker(_lock);
+
+	// reset instead of erasing, as evaluating threads might still hold on to the facts
+	if (const auto it = _facts.find(Utils::RefrKey(a_refr)); it != _facts.end()) {
+		it->second->Reset();
+	}
+}
+
+void ActorFactCache::Clear()
+{
+	WriteLocker locker(_lock);
+
+	for (const auto& facts : _facts | std::views::values) {
+		facts->Reset();
+	}
+	_facts.clear();
+}
+
+uint32_t ActorFactCache::GetFact(RE::Actor* a_actor, ActorFacts::Fact a_fact)
+{
+	if (!Settings::bShareActorFacts) {
+		return ActorFacts::Compute(a_fact, a_actor);
+	}
+
+	return GetFacts(a_actor)->Get(a_fact, a_actor);
+}
+
+std::shared_ptr<ActorFacts> ActorFactCache::GetFacts(RE::Actor* a_actor)
+{
+	const uint32_t frame = g_durationOfApplicationRunTimeMS;
+
+	// conditions of one evaluation ask about the same actor in a row, so remember the last one per thread to skip the map lookup
+	struct LastFacts
+	{
+		const RE::Actor* actor = nullptr;
+		uint32_t frame = 0;
+		std::shared_ptr<ActorFacts> facts = nullptr;
+	};
+	static thread_local LastFacts lastFacts;
+
+	if (lastFacts.actor == a_actor && lastFacts.frame == frame && lastFacts.facts) {
+		return lastFacts.facts;
+	}
+
+	const Utils::RefrKey key(a_actor);
+	std::shared_ptr<ActorFacts> facts = nullptr;
+
+	{
+		ReadLocker locker(_lock);
+
+		if (_frame == frame) {
+			if (const auto it = _facts.find(key); it != _facts.end()) {
+				facts = it->second;
+			}
+		}
+	}
+
+	if (!facts) {
+		WriteLocker locker(_lock);
+
+		// facts from previous frames are outdated
+		if (_frame != frame) {
+			_frame = frame;
+			_facts.clear();
+		}
+
+		facts = _facts.try_emplace(key, std::make_shared<ActorFacts>()).first->second;
+	}
+
+	lastFacts = { a_actor, frame, facts };
+
+	return facts;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Utils.h"
+
+// state of an actor that many conditions read, each fact filled at most once per frame the first time a condition asks for it
+class ActorFacts
+{
+public:
+	enum class Fact : uint32_t
+	{
+		kIsFemale,
+		kLevel,
+		kIsInCombat,
+		kIsWeaponDrawn,
+		kIsSneaking,
+		kIsSprinting,
+		kIsInMidair,
+		kIsOnMount,
+		kIsOnStairs,
+		kLightLevel,
+		kSurfaceMaterial,
+
+		kTotal
+	};
+
+	static constexpr size_t factCount = static_cast<size_t>(Fact::kTotal);
+
+	// value stored for the surface material when the actor has no character controller
+	static constexpr uint32_t noSurfaceMaterial = std::numeric_limits<uint32_t>::max();
+
+	[[nodiscard]] uint32_t Get(Fact a_fact, RE::Actor* a_actor);
+	void Reset() { _filled.store(0, std::memory_order_release); }
+
+	[[nodiscard]] static uint32_t Compute(Fact a_fact, RE::Actor* a_actor);
+	[[nodiscard]] static std::string_view GetFactName(Fact a_fact);
+
+	// summed over the per-thread counters, so reading a fact never touches a shared cache line
+	[[nodiscard]] static uint64_t GetHitCount(Fact a_fact);
+	[[nodiscard]] static uint64_t GetMissCount(Fact a_fact);
+
+private:
+	std::atomic<uint32_t> _filled = 0;
+	std::array<std::atomic<uint32_t>, factCount> _values{};
+};
+
+// hands out the facts of an actor for the current frame, computing them directly when sharing is disabled
+class ActorFactCache final
+{
+public:
+	static ActorFactCache& GetSingleton()
+	{
+		static ActorFactCache singleton;
+		return singleton;
+	}
+
+	[[nodiscard]] bool IsFemale(RE::Actor* a_actor) { return GetFact(a_actor, ActorFacts::Fact::kIsFemale) != 0; }
+	[[nodiscard]] uint16_t GetLevel(RE::Actor* a_actor) { return static_cast<uint16_t>(GetFact(a_actor, ActorFacts::Fact::kLevel)); }
+	[[nodiscard]] bool IsInCombat(RE::Actor* a_actor) { return GetFact(a_actor, ActorFacts::Fact::kIsInCombat) != 0; }
+	[[nodiscard]] bool IsWeaponDrawn(RE::Actor* a_actor) { return GetFact(a_actor, ActorFacts::Fact::kIsWeaponDrawn) != 0; }
+	[[nodiscard]] bool IsSneaking(RE::Actor* a_actor) { return GetFact(a_actor, ActorFacts::Fact::kIsSneaking) != 0; }
+	[[nodiscard]] bool IsSprinting(RE::Actor* a_actor) { return GetFact(a_actor, ActorFacts::Fact::kIsSprinting) != 0; }
+	[[nodiscard]] bool IsInMidair(RE::Actor* a_actor) { return GetFact(a_actor, ActorFacts::Fact::kIsInMidair) != 0; }
+	[[nodiscard]] bool IsOnMount(RE::Actor* a_actor) { return GetFact(a_actor, ActorFacts::Fact::kIsOnMount) != 0; }
+	[[nodiscard]] bool IsOnStairs(RE::Actor* a_actor) { return GetFact(a_actor, ActorFacts::Fact::kIsOnStairs) != 0; }
+	[[nodiscard]] float GetLightLevel(RE::Actor* a_actor) { return std::bit_cast<float>(GetFact(a_actor, ActorFacts::Fact::kLightLevel)); }
+	[[nodiscard]] bool GetSurfaceMaterial(RE::Actor* a_actor, RE::MATERIAL_ID& a_outMaterialID);
+
+	void Invalidate(RE::TESObjectREFR* a_refr);
+	void Clear();
+
+private:
+	ActorFactCache() = default;
+	ActorFactCache(const ActorFactCache&) = delete;
+	ActorFactCache(ActorFactCache&&) = delete;
+	~ActorFactCache() = default;
+
+	ActorFactCache& operator=(const ActorFactCache&) = delete;
+	ActorFactCache& operator=(ActorFactCache&&) = delete;
+
+	[[nodiscard]] uint32_t GetFact(RE::Actor* a_actor, ActorFacts::Fact a_fact);
+	[[nodiscard]] std::shared_ptr<ActorFacts> GetFacts(RE::Actor* a_actor);
+
+	mutable SharedLock _lock;
+	uint32_t _frame = 0;
+	std::unordered_map<Utils::RefrKey, std::shared_ptr<ActorFacts>, Utils::RefrKey::Hash> _facts;
+};
@@ -1,4 +1,5 @@
 #include "BaseConditions.h"
+#include "ConditionProfiler.h"
 #include "OpenAnimationReplacer.h"
 #include "UI/UICommon.h"
 #include "Utils.h"
@@ -28,6 +29,20 @@ namespace Conditions
 		return Hash(a_str, a_size);
 	}
 
+	// evaluates a condition of a set, recording its cost if the profiler is enabled
+	static bool EvaluateCondition(const ICondition* a_condition, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator, SubMod* a_parentSubMod)
+	{
+		if (!ConditionProfiler::IsEnabled() || a_condition->IsDisabled()) {
+			return a_condition->Evaluate(a_refr, a_clipGenerator, a_parentSubMod);
+		}
+
+		const uint64_t startTime = ConditionProfiler::Now();
+		const bool bResult = a_condition->Evaluate(a_refr, a_clipGenerator, a_parentSubMod);
+		ConditionProfiler::GetSingleton().RecordCondition(a_condition, ConditionProfiler::Now() - startTime, bResult);
+
+		return bResult;
+	}
+
 	void ConditionBase::Initialize(void* a_value)
 	{
 		auto& value = *static_cast<rapidjson::Value*>(a_value);
@@ -125,19 +140,18 @@ namespace Conditions
 
 	bool ConditionSet::EvaluateAll(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator, SubMod* a_parentSubMod, bool a_bForceTrace) const
 	{
-		ReadLocker locker(_lock);
+		const auto entries = GetSnapshot();
 
-		auto& animationLog = AnimationLog::GetSingleton();
-		ReplacementTrace* trace = a_bForceTrace || animationLog.ShouldLogAnimationsForRefr(a_refr) ? OpenAnimationReplacer::GetSingleton().GetTrace(a_refr, a_clipGenerator) : nullptr;
+		ReplacementTrace* trace = a_bForceTrace ? OpenAnimationReplacer::GetSingleton().GetTrace(a_refr, a_clipGenerator) : EvaluationContext::ResolveTrace(a_refr, a_clipGenerator);
 
 		if (trace) {
 			// if we're tracing, we need to do it in a classic for loop to know where it failed
-			for (const auto& condition : _entries) {
-				bool bHasMultiComponent = Utils::ConditionHasMultiComponent(condition.get());
+			for (const auto condition : entries) {
+				bool bHasMultiComponent = Utils::ConditionHasMultiComponent(condition);
 				if (bHasMultiComponent) {
 					trace->StartTracingMultiCondition();
 				}
-				bool bSuccess = condition->Evaluate(a_refr, a_clipGenerator, a_parentSubMod);
+				bool bSuccess = EvaluateCondition(condition, a_refr, a_clipGenerator, a_parentSubMod);
 				ReplacementTrace::Step::StepResult result;
 				if (condition->IsDisabled()) {
 					result = ReplacementTrace::Step::StepResult::kDisabled;
@@ -145,9 +159,9 @@ namespace Conditions
 					result = bSuccess ? ReplacementTrace::Step::StepResult::kSuccess : ReplacementTrace::Step::StepResult::kFail;
 				}
 				if (bHasMultiComponent) {
-					trace->EndTracingMultiCondition(condition.get(), result);
+					trace->EndTracingMultiCondition(condition, result);
 				} else {
-					trace->TraceCondition(condition.get(), result);
+					trace->TraceCondition(condition, result);
 				}
 
 				if (!bSuccess) {
@@ -156,39 +170,38 @@ namespace Conditions
 			}
 			return true;
 		} else {
-			return std::ranges::all_of(_entries, [&](auto& a_condition) { return a_condition->Evaluate(a_refr, a_clipGenerator, a_parentSubMod); });
+			return std::ranges::all_of(entries, [&](const auto a_condition) { return EvaluateCondition(a_condition, a_refr, a_clipGenerator, a_parentSubMod); });
 		}
 	}
 
 	bool ConditionSet::EvaluateAny(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator, SubMod* a_parentSubMod, bool a_bForceTrace) const
 	{
-		ReadLocker locker(_lock);
+		const auto entries = GetSnapshot();
 
 		//return std::ranges::any_of(_conditions, [&](auto& a_condition) { return a_condition->Evaluate(a_refr, a_clipGenerator); });
 
-		auto& animationLog = AnimationLog::GetSingleton();
-		ReplacementTrace* trace = a_bForceTrace || animationLog.ShouldLogAnimationsForRefr(a_refr) ? OpenAnimationReplacer::GetSingleton().GetTrace(a_refr, a_clipGenerator) : nullptr;
+		ReplacementTrace* trace = a_bForceTrace ? OpenAnimationReplacer::GetSingleton().GetTrace(a_refr, a_clipGenerator) : EvaluationContext::ResolveTrace(a_refr, a_clipGenerator);
 
 		// skip disabled conditions and also return true when all conditions are disabled
 		bool bAnyMet = false;
 		bool bAllDisabled = true;
-		for (const auto& condition : _entries) {
+		for (const auto condition : entries) {
 			if (!condition->IsDisabled()) {
 				bAllDisabled = false;
 				bool bHasMultiComponent = false;
 				if (trace) {
-					bHasMultiComponent = Utils::ConditionHasMultiComponent(condition.get());
+					bHasMultiComponent = Utils::ConditionHasMultiComponent(condition);
 				}
 				if (trace && bHasMultiComponent) {
 					trace->StartTracingMultiCondition();
 				}
-				bool bSuccess = condition->Evaluate(a_refr, a_clipGenerator, a_parentSubMod);
+				bool bSuccess = EvaluateCondition(condition, a_refr, a_clipGenerator, a_parentSubMod);
 				if (trace) {
 					ReplacementTrace::Step::StepResult result = bSuccess ? ReplacementTrace::Step::StepResult::kSuccess : ReplacementTrace::Step::StepResult::kFail;
 					if (bHasMultiComponent) {
-						trace->EndTracingMultiCondition(condition.get(), result);
+						trace->EndTracingMultiCondition(condition, result);
 					} else {
-						trace->TraceCondition(condition.get(), result);
+						trace->TraceCondition(condition, result);
 					}
 				}
 				if (bSuccess) {
@@ -196,7 +209,7 @@ namespace Conditions
 					break;
 				}
 			} else if (trace) {
-				trace->TraceCondition(condition.get(), ReplacementTrace::Step::StepResult::kDisabled);
+				trace->TraceCondition(condition, ReplacementTrace::Step::StepResult::kDisabled);
 			}
 		}
 
@@ -172,11 +172,9 @@ namespace Functions
 
 	bool FunctionSet::Run(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator, SubMod* a_parentSubMod, Trigger* a_trigger) const
 	{
-		ReadLocker locker(_lock);
-
 		bool bRanFunction = false;
 
-		for (auto& function : _entries) {
+		for (const auto function : GetSnapshot()) {
 			if (GetFunctionSetType() == FunctionSetType::kOnTrigger) {
 				if (a_trigger && function->HasTrigger(a_trigger->event, a_trigger->payload)) {
 					if (function->Run(a_refr, a_clipGenerator, a_parentSubMod, a_trigger)) {
@@ -193,6 +191,56 @@ namespace Functions
 		return bRanFunction;
 	}
 
+	const std::vector<IFunction*>* FunctionSet::GetFunctionsForEvent(const RE::BSFixedString& a_event) const
+	{
+		auto index = _triggerIndex.load(std::memory_order_acquire);
+		if (!index) {
+			index = BuildTriggerIndex();
+		}
+
+		if (const auto it = index->functionsByEvent.find(a_event.data()); it != index->functionsByEvent.end()) {
+			return &it->second;
+		}
+
+		return nullptr;
+	}
+
+	void FunctionSet::InvalidateTriggerIndex() const
+	{
+		Locker locker(_triggerIndexLock);
+
+		// the index might still be read by an event on another thread
+		if (const auto index = _triggerIndex.exchange(nullptr, std::memory_order_acq_rel)) {
+			SnapshotReclaimer::GetSingleton().Retire(std::unique_ptr<const TriggerIndex>(index));
+		}
+	}
+
+	const FunctionSet::TriggerIndex* FunctionSet::BuildTriggerIndex() const
+	{
+		Locker locker(_triggerIndexLock);
+
+		// another thread might have built it while we were waiting
+		if (const auto index = _triggerIndex.load(std::memory_order_acquire)) {
+			return index;
+		}
+
+		auto index = std::make_unique<TriggerIndex>();
+		for (const auto function : GetSnapshot()) {
+			function->ForEachTrigger([&](const Trigger& a_trigger) {
+				RE::BSFixedString eventName(a_trigger.event.data());
+				auto& functions = index->functionsByEvent[eventName.data()];
+				if (functions.empty() || functions.back() != function) {
+					functions.push_back(function);
+				}
+				index->eventNames.emplace_back(std::move(eventName));
+				return RE::BSVisit::BSVisitControl::kContinue;
+			});
+		}
+
+		_triggerIndex.store(index.get(), std::memory_order_release);
+		return index.release();
+	}
+
 	void FunctionSet::SetAsParentImpl(std::unique_ptr<IFunction>& a_function)
 	{
 		a_function->SetParentSet(this);
@@ -106,6 +106,8 @@ namespace Functions
 		FunctionSet(IMultiFunctionComponent* a_parentMultiFunctionComponent) :
 			_parentMultiFunctionComponent(a_parentMultiFunctionComponent) {}
 
+		~FunctionSet() { delete _triggerIndex.load(std::memory_order_acquire); }
+
 		bool Run(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator, SubMod* a_parentSubMod, Trigger* a_trigger = nullptr) const;
 
 		void SetAsParentImpl(std::unique_ptr<IFunction>& a_function);
@@ -118,11 +120,31 @@ namespace Functions
 		[[nodiscard]] const IFunction* GetParentFunction() const;
 		FunctionSetType GetFunctionSetType() const { return _type; }
 
+		// functions with at least one trigger on the given event in set order, or nullptr if nothing listens for it. The payload still has to be checked with HasTrigger
+		[[nodiscard]] const std::vector<IFunction*>* GetFunctionsForEvent(const RE::BSFixedString& a_event) const;
+
+		// must be called after the triggers of any function in the set were changed
+		void InvalidateTriggerIndex() const;
+
+		void OnSnapshotPublishedImpl() const { InvalidateTriggerIndex(); }
+
 	protected:
 		FunctionSetType _type = FunctionSetType::kNone;
 
 	private:
+		// keyed by the address of the interned event name, so a lookup is a single pointer hash
+		struct TriggerIndex
+		{
+			std::unordered_map<const char*, std::vector<IFunction*>> functionsByEvent;
+			std::vector<RE::BSFixedString> eventNames;  // keeps the keys interned
+		};
+
+		const TriggerIndex* BuildTriggerIndex() const;
+
 		IMultiFunctionComponent* _parentMultiFunctionComponent = nullptr;
+
+		mutable ExclusiveLock _triggerIndexLock;
+		mutable std::atomic<const TriggerIndex*> _triggerIndex = nullptr;
 	};
 
 	class MultiFunctionComponent : public IMultiFunctionComponent
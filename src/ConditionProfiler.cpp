@@ -0,0 +1,207 @@
+#include "ConditionProfiler.h"
+
+#include "ReplacerMods.h"
+
+#include <fstream>
+
+void ConditionProfiler::Slot::Record(uint64_t a_nanoseconds, bool a_bResult)
+{
+	calls.fetch_add(1, std::memory_order_relaxed);
+	if (a_bResult) {
+		trueCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	totalNanoseconds.fetch_add(a_nanoseconds, std::memory_order_relaxed);
+	histogram[std::min<size_t>(std::bit_width(a_nanoseconds), histogramBucketCount - 1)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void ConditionProfiler::Slot::Reset()
+{
+	calls.store(0, std::memory_order_relaxed);
+	trueCount.store(0, std::memory_order_relaxed);
+	totalNanoseconds.store(0, std::memory_order_relaxed);
+	for (auto& bucket : histogram) {
+		bucket.store(0, std::memory_order_relaxed);
+	}
+}
+
+template <size_t Capacity>
+template <class GetName>
+ConditionProfiler::Slot* ConditionProfiler::Table<Capacity>::FindOrAdd(const void* a_key, GetName&& a_getName)
+{
+	size_t index = std::hash<const void*>{}(a_key) % Capacity;
+	for (size_t i = 0; i < Capacity; ++i) {
+		auto& slot = slots[index];
+		const auto key = slot.key.load(std::memory_order_relaxed);
+		if (key == a_key) {
+			return &slot;
+		}
+		if (key == nullptr) {
+			slot.name = a_getName();
+			slot.key.store(a_key, std::memory_order_release);
+			return &slot;
+		}
+		index = (index + 1) % Capacity;
+	}
+
+	// table is full, stop recording new entries
+	return nullptr;
+}
+
+void ConditionProfiler::RecordCondition(const Conditions::ICondition* a_condition, uint64_t a_nanoseconds, bool a_bResult)
+{
+	// all conditions of the same class share a vtable
+	const auto key = *reinterpret_cast<const void* const*>(a_condition);
+	if (const auto slot = GetThreadTables().conditions.FindOrAdd(key, [a_condition]() { return std::string(a_condition->GetName().c_str()); })) {
+		slot->Record(a_nanoseconds, a_bResult);
+	}
+}
+
+void ConditionProfiler::RecordSubMod(const SubMod* a_subMod, uint64_t a_nanoseconds, bool a_bResult)
+{
+	const auto getName = [a_subMod]() {
+		if (const auto parentMod = a_subMod->GetParentMod()) {
+			return std::format("{} / {}", parentMod->GetName(), a_subMod->GetName());
+		}
+		return std::string(a_subMod->GetName());
+	};
+
+	if (const auto slot = GetThreadTables().subMods.FindOrAdd(a_subMod, getName)) {
+		slot->Record(a_nanoseconds, a_bResult);
+	}
+}
+
+ConditionProfiler::ThreadTables& ConditionProfiler::GetThreadTables()
+{
+	static thread_local ThreadTables* threadTables = nullptr;
+
+	if (!threadTables) {
+		// only taken once per thread. The tables outlive the thread, so the results stay available
+		Locker locker(_tablesLock);
+		threadTables = _tables.emplace_back(std::make_unique<ThreadTables>()).get();
+	}
+
+	return *threadTables;
+}
+
+template <size_t Capacity>
+std::vector<ConditionProfiler::Stats> ConditionProfiler::Aggregate(Table<Capacity> ThreadTables::*a_table) const
+{
+	struct Accumulated
+	{
+		Stats stats;
+		std::array<uint64_t, histogramBucketCount> histogram{};
+	};
+
+	std::unordered_map<std::string, Accumulated> accumulated;
+
+	{
+		Locker locker(_tablesLock);
+
+		for (const auto& tables : _tables) {
+			for (const auto& slot : ((*tables).*a_table).slots) {
+				if (slot.key.load(std::memory_order_acquire) == nullptr) {
+					continue;
+				}
+
+				auto& entry = accumulated[slot.name];
+				entry.stats.calls += slot.calls.load(std::memory_order_relaxed);
+				entry.stats.trueCount += slot.trueCount.load(std::memory_order_relaxed);
+				entry.stats.totalNanoseconds += slot.totalNanoseconds.load(std::memory_order_relaxed);
+				for (size_t i = 0; i < histogramBucketCount; ++i) {
+					entry.histogram[i] += slot.histogram[i].load(std::memory_order_relaxed);
+				}
+			}
+		}
+	}
+
+	// percentiles are reported as the upper bound of the bucket they fall in
+	const auto getPercentile = [](const std::array<uint64_t, histogramBucketCount>& a_histogram, uint64_t a_count, double a_percentile) -> uint64_t {
+		const auto threshold = static_cast<uint64_t>(std::ceil(static_cast<double>(a_count) * a_percentile));
+		uint64_t cumulative = 0;
+		for (size_t i = 0; i < histogramBucketCount; ++i) {
+			cumulative += a_histogram[i];
+			if (cumulative >= threshold) {
+				return 1ull << i;
+			}
+		}
+		return 1ull << (histogramBucketCount - 1);
+	};
+
+	std::vector<Stats> result;
+	result.reserve(accumulated.size());
+	for (auto& [name, entry] : accumulated) {
+		if (entry.stats.calls == 0) {
+			continue;
+		}
+
+		uint64_t histogramCount = 0;
+		for (const auto bucket : entry.histogram) {
+			histogramCount += bucket;
+		}
+
+		entry.stats.name = name;
+		entry.stats.p50Nanoseconds = getPercentile(entry.histogram, histogramCount, 0.5);
+		entry.stats.p99Nanoseconds = getPercentile(entry.histogram, histogramCount, 0.99);
+		result.emplace_back(std::move(entry.stats));
+	}
+
+	return result;
+}
+
+std::vector<ConditionProfiler::Stats> ConditionProfiler::GetConditionStats() const
+{
+	return Aggregate(&ThreadTables::conditions);
+}
+
+std::vector<ConditionProfiler::Stats> ConditionProfiler::GetSubModStats() const
+{
+	return Aggregate(&ThreadTables::subMods);
+}
+
+void ConditionProfiler::Reset()
+{
+	Locker locker(_tablesLock);
+
+	// counters are zeroed in place, the owning threads keep their slots
+	for (const auto& tables : _tables) {
+		for (auto& slot : tables->conditions.slots) {
+			slot.Reset();
+		}
+		for (auto& slot : tables->subMods.slots) {
+			slot.Reset();
+		}
+	}
+}
+
+bool ConditionProfiler::ExportToCSV(const std::filesystem::path& a_path) const
+{
+	std::ofstream file(a_path);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	const auto escape = [](std::string_view a_text) {
+		std::string escaped = "\"";
+		for (const auto c : a_text) {
+			if (c == '"') {
+				escaped += '"';
+			}
+			escaped += c;
+		}
+		escaped += '"';
+		return escaped;
+	};
+
+	const auto write = [&](std::string_view a_kind, const std::vector<Stats>& a_stats) {
+		for (const auto& stats : a_stats) {
+			const uint64_t averageNanoseconds = stats.calls > 0 ? stats.totalNanoseconds / stats.calls : 0;
+			file << std::format("{},{},{},{},{},{},{},{}\n", a_kind, escape(stats.name), stats.calls, stats.trueCount, stats.totalNanoseconds, averageNanoseconds, stats.p50Nanoseconds, stats.p99Nanoseconds);
+		}
+	};
+
+	file << "Kind,Name,Calls,True,Total (ns),Average (ns),P50 (ns),P99 (ns)\n";
+	write("Condition"sv, GetConditionStats());
+	write("Submod"sv, GetSubModStats());
+
+	return file.good();
+}
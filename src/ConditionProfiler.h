@@ -0,0 +1,92 @@
+#pragma once
+
+namespace Conditions
+{
+	class ICondition;
+}
+
+class SubMod;
+
+// opt-in profiler of the cost of conditions (per condition type) and submods. Each evaluating thread records into its own table, so the evaluation path takes no locks
+class ConditionProfiler final
+{
+public:
+	static ConditionProfiler& GetSingleton()
+	{
+		static ConditionProfiler singleton;
+		return singleton;
+	}
+
+	struct Stats
+	{
+		std::string name;
+		uint64_t calls = 0;
+		uint64_t trueCount = 0;
+		uint64_t totalNanoseconds = 0;
+		uint64_t p50Nanoseconds = 0;
+		uint64_t p99Nanoseconds = 0;
+	};
+
+	[[nodiscard]] static bool IsEnabled() { return bEnabled.load(std::memory_order_relaxed); }
+	[[nodiscard]] static uint64_t Now() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+	void RecordCondition(const Conditions::ICondition* a_condition, uint64_t a_nanoseconds, bool a_bResult);
+	void RecordSubMod(const SubMod* a_subMod, uint64_t a_nanoseconds, bool a_bResult);
+
+	[[nodiscard]] std::vector<Stats> GetConditionStats() const;
+	[[nodiscard]] std::vector<Stats> GetSubModStats() const;
+	void Reset();
+	bool ExportToCSV(const std::filesystem::path& a_path) const;
+
+	// not saved to the settings, the profiler is only meant to be enabled while investigating
+	static inline std::atomic_bool bEnabled = false;
+
+private:
+	ConditionProfiler() = default;
+	ConditionProfiler(const ConditionProfiler&) = delete;
+	ConditionProfiler(ConditionProfiler&&) = delete;
+	~ConditionProfiler() = default;
+
+	ConditionProfiler& operator=(const ConditionProfiler&) = delete;
+	ConditionProfiler& operator=(ConditionProfiler&&) = delete;
+
+	// bucket i counts durations of bit width i, so roughly [2^(i-1), 2^i) nanoseconds
+	static constexpr size_t histogramBucketCount = 32;
+
+	struct Slot
+	{
+		std::atomic<const void*> key = nullptr;
+		std::string name;  // written by the owning thread before the key is published, never changed after
+		std::atomic<uint64_t> calls = 0;
+		std::atomic<uint64_t> trueCount = 0;
+		std::atomic<uint64_t> totalNanoseconds = 0;
+		std::array<std::atomic<uint64_t>, histogramBucketCount> histogram{};
+
+		void Record(uint64_t a_nanoseconds, bool a_bResult);
+		void Reset();
+	};
+
+	// insert-only open addressing table, written only by the owning thread and read by the UI
+	template <size_t Capacity>
+	struct Table
+	{
+		template <class GetName>
+		Slot* FindOrAdd(const void* a_key, GetName&& a_getName);
+
+		std::array<Slot, Capacity> slots;
+	};
+
+	struct ThreadTables
+	{
+		Table<512> conditions;  // keyed by the vtable of the condition, so per condition type
+		Table<4096> subMods;
+	};
+
+	[[nodiscard]] ThreadTables& GetThreadTables();
+
+	template <size_t Capacity>
+	[[nodiscard]] std::vector<Stats> Aggregate(Table<Capacity> ThreadTables::*a_table) const;
+
+	mutable ExclusiveLock _tablesLock;
+	std::vector<std::unique_ptr<ThreadTables>> _tables;
+};
@@ -1,7 +1,12 @@
 #include "Conditions.h"
+#include "ActiveEffectSnapshot.h"
+#include "ActorFacts.h"
 #include "DetectedProblems.h"
+#include "GraphVariableCache.h"
+#include "InventoryCache.h"
 #include "Offsets.h"
 #include "OpenAnimationReplacer.h"
+#include "TargetCache.h"
 #include "Utils.h"
 
 #include <imgui_stdlib.h>
@@ -660,16 +665,7 @@ namespace Conditions
 	{
 		if (formComponent->IsValid() && a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				const auto inv = actor->GetInventory([this](const RE::TESBoundObject& a_object) {
-					return a_object.GetFormID() == formComponent->GetTESFormValue()->GetFormID();
-				});
-
-				for (const auto& invData : inv | std::views::values) {
-					const auto& [count, entry] = invData;
-					if (count > 0 && entry->IsWorn()) {
-						return true;
-					}
-				}
+				return InventoryCache::GetSingleton().GetItemInfo(actor, formComponent->GetTESFormValue()->GetFormID()).bWorn;
 			}
 		}
 
@@ -699,9 +695,7 @@ namespace Conditions
 	{
 		if (a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				if (const auto tesNPC = actor->GetActorBase()) {
-					return tesNPC->IsFemale();
-				}
+				return ActorFactCache::GetSingleton().IsFemale(actor);
 			}
 		}
 
@@ -797,28 +791,8 @@ namespace Conditions
 
 					if (boolComponent->GetBoolValue()) {
 						// active effects only, do the same thing as the game does but check the inactive flag as well
-						const auto matchesEffect = [&](RE::ActiveEffect* ae) -> bool {
-							return ae && !ae->flags.any(RE::ActiveEffect::Flag::kInactive) && ae->GetBaseObject() == magicEffect;
-						};
-
-						if (REL::Module::IsVR()) {  // VR must use a visitor since it doesn't have GetActiveEffectList
-							bool bHasEffect = false;
-							magicTarget->VisitActiveEffects([&](RE::ActiveEffect* ae) {
-								if (matchesEffect(ae)) {
-									bHasEffect = true;
-									return RE::BSContainer::ForEachResult::kStop;
-								}
-								return RE::BSContainer::ForEachResult::kContinue;
-							});
-							return bHasEffect;
-						} else {
-							if (auto activeEffects = magicTarget->GetActiveEffectList()) {
-								for (auto* ae : *activeEffects) {
-									if (matchesEffect(ae)) {
-										return true;
-									}
-								}
-							}
+						if (const auto snapshot = ActiveEffectSnapshots::GetSingleton().Get(actor)) {
+							return snapshot->HasEffect(magicEffect->GetFormID());
 						}
 					} else {
 						return magicTarget->HasMagicEffect(magicEffect);
@@ -853,28 +827,16 @@ namespace Conditions
 
 				if (boolComponent->GetBoolValue()) {
 					// active effects only, do the same thing as the game does but check the inactive flag as well
-					const auto matchesEffect = [&](RE::ActiveEffect* ae) -> bool {
-						return ae && !ae->flags.any(RE::ActiveEffect::Flag::kInactive) && keywordComponent->HasKeyword(ae->GetBaseObject());
-					};
-
-					if (REL::Module::IsVR()) {  // VR must use a visitor since it doesn't have GetActiveEffectList
-						bool bHasEffect = false;
-						magicTarget->VisitActiveEffects([&](RE::ActiveEffect* ae) {
-							if (matchesEffect(ae)) {
-								bHasEffect = true;
+					if (const auto snapshot = ActiveEffectSnapshots::GetSingleton().Get(actor)) {
+						bool bFound = false;
+						keywordComponent->keyword.ForEachKeyword([&](auto a_kywd) {
+							if (snapshot->HasKeyword(a_kywd->GetFormID())) {
+								bFound = true;
 								return RE::BSContainer::ForEachResult::kStop;
 							}
 							return RE::BSContainer::ForEachResult::kContinue;
 						});
-						return bHasEffect;
-					} else {
-						if (auto activeEffects = magicTarget->GetActiveEffectList()) {
-							for (RE::ActiveEffect* activeEffect : *activeEffects) {
-								if (matchesEffect(activeEffect)) {
-									return true;
-								}
-							}
-						}
+						return bFound;
 					}
 				} else {
 					bool bFound = false;
@@ -967,7 +929,7 @@ namespace Conditions
 	{
 		if (a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				return std::to_string(actor->GetLevel()).data();
+				return std::to_string(ActorFactCache::GetSingleton().GetLevel(actor)).data();
 			}
 		}
 
@@ -978,7 +940,7 @@ namespace Conditions
 	{
 		if (a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				return comparisonComponent->GetComparisonResult(actor->GetLevel(), numericComponent->GetNumericValue(a_refr));
+				return comparisonComponent->GetComparisonResult(ActorFactCache::GetSingleton().GetLevel(actor), numericComponent->GetNumericValue(a_refr));
 			}
 		}
 
@@ -1295,7 +1257,7 @@ namespace Conditions
 	{
 		if (a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				return actor->IsSneaking();
+				return ActorFactCache::GetSingleton().IsSneaking(actor);
 			}
 		}
 
@@ -1306,7 +1268,7 @@ namespace Conditions
 	{
 		if (a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				return actor->AsActorState()->IsSprinting();
+				return ActorFactCache::GetSingleton().IsSprinting(actor);
 			}
 		}
 
@@ -1317,7 +1279,7 @@ namespace Conditions
 	{
 		if (a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				return actor->IsInMidair();
+				return ActorFactCache::GetSingleton().IsInMidair(actor);
 			}
 		}
 
@@ -1328,7 +1290,7 @@ namespace Conditions
 	{
 		if (a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				return actor->IsInCombat();
+				return ActorFactCache::GetSingleton().IsInCombat(actor);
 			}
 		}
 
@@ -1339,7 +1301,7 @@ namespace Conditions
 	{
 		if (a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				return actor->AsActorState()->IsWeaponDrawn();
+				return ActorFactCache::GetSingleton().IsWeaponDrawn(actor);
 			}
 		}
 
@@ -1627,7 +1589,7 @@ namespace Conditions
 
 			// seems that the return is correct regardless of the type
 			float f;
-			return a_refr->GetGraphVariableFloat(textComponent->GetTextValue(), f);
+			return GraphVariableCache::GetSingleton().GetFloat(a_refr, textComponent->text.GetFixedValue(), f);
 		}
 
 		return false;
@@ -2199,14 +2161,7 @@ namespace Conditions
 
 		if (formComponent->IsValid() && a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				const auto inv = actor->GetInventory([this](const RE::TESBoundObject& a_object) {
-					return a_object.GetFormID() == formComponent->GetTESFormValue()->GetFormID();
-				});
-
-				for (const auto& invData : inv | std::views::values) {
-					const auto& [itemCount, entry] = invData;
-					count += itemCount;
-				}
+				count = InventoryCache::GetSingleton().GetItemInfo(actor, formComponent->GetTESFormValue()->GetFormID()).count;
 			}
 		}
 
@@ -2389,7 +2344,7 @@ namespace Conditions
 	{
 		if (a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				return actor->IsOnMount();
+				return ActorFactCache::GetSingleton().IsOnMount(actor);
 			}
 		}
 
@@ -2606,7 +2561,7 @@ namespace Conditions
 			if (const auto actor = a_refr->As<RE::Actor>()) {
 				RE::TESObjectREFRPtr target = nullptr;
 				const auto targetType = static_cast<Utils::TargetType>(targetTypeComponent->GetNumericValue(a_refr));
-				return Utils::GetCurrentTarget(actor, targetType, target);
+				return TargetCache::GetSingleton().GetCurrentTarget(actor, targetType, target);
 			}
 		}
 
@@ -2654,7 +2609,7 @@ namespace Conditions
 			if (const auto actor = a_refr->As<RE::Actor>()) {
 				RE::TESObjectREFRPtr target = nullptr;
 				const auto targetType = static_cast<Utils::TargetType>(targetTypeComponent->GetNumericValue(a_refr));
-				if (Utils::GetCurrentTarget(actor, targetType, target)) {
+				if (TargetCache::GetSingleton().GetCurrentTarget(actor, targetType, target)) {
 					return target;
 				}
 			}
@@ -2717,7 +2672,7 @@ namespace Conditions
 			if (const auto actor = a_refr->As<RE::Actor>()) {
 				RE::TESObjectREFRPtr target = nullptr;
 				const auto targetType = static_cast<Utils::TargetType>(targetTypeComponent->GetNumericValue(a_refr));
-				if (Utils::GetCurrentTarget(actor, targetType, target)) {
+				if (TargetCache::GetSingleton().GetCurrentTarget(actor, targetType, target)) {
 					return target;
 				}
 			}
@@ -3112,17 +3067,12 @@ namespace Conditions
 
 		if (keywordComponent->IsValid() && a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				const auto inv = actor->GetInventory([this](const RE::TESBoundObject& a_object) {
+				count = Utils::GetInventoryItemCount(actor, [this](const RE::TESBoundObject& a_object) {
 					if (const auto bgsKeywordForm = a_object.As<RE::BGSKeywordForm>()) {
 						return keywordComponent->HasKeyword(bgsKeywordForm);
 					}
 					return false;
 				});
-
-				for (const auto& invData : inv | std::views::values) {
-					const auto& [itemCount, entry] = invData;
-					count += itemCount;
-				}
 			}
 		}
 
@@ -3166,7 +3116,7 @@ namespace Conditions
 			if (const auto actor = a_refr->As<RE::Actor>()) {
 				RE::TESObjectREFRPtr target = nullptr;
 				const auto targetType = static_cast<Utils::TargetType>(targetTypeComponent->GetNumericValue(a_refr));
-				if (Utils::GetCurrentTarget(actor, targetType, target)) {
+				if (TargetCache::GetSingleton().GetCurrentTarget(actor, targetType, target)) {
 					return target;
 				}
 			}
@@ -3181,7 +3131,7 @@ namespace Conditions
 			if (const auto actor = a_refr->As<RE::Actor>()) {
 				RE::TESObjectREFRPtr target = nullptr;
 				const auto targetType = static_cast<Utils::TargetType>(targetTypeComponent->GetNumericValue(a_refr));
-				if (Utils::GetCurrentTarget(actor, targetType, target)) {
+				if (TargetCache::GetSingleton().GetCurrentTarget(actor, targetType, target)) {
 					const auto refAngle = a_refr->GetAngleZ();
 					const auto targetAngle = target->GetAngleZ();
 
@@ -3219,12 +3169,10 @@ namespace Conditions
 				if (const auto target = GetTarget(a_refr)) {
 					if (boolComponent->GetBoolValue()) {
 						if (const auto targetActor = target->As<RE::Actor>()) {
-							bool a2 = false;
-							return targetActor->HasLineOfSight(a_refr, a2);
+							return TargetCache::GetSingleton().HasLineOfSight(targetActor, a_refr);
 						}
 					} else {
-						bool a2 = false;
-						return actor->HasLineOfSight(target.get(), a2);
+						return TargetCache::GetSingleton().HasLineOfSight(actor, target.get());
 					}
 				}
 			}
@@ -3239,7 +3187,7 @@ namespace Conditions
 			if (const auto actor = a_refr->As<RE::Actor>()) {
 				RE::TESObjectREFRPtr target = nullptr;
 				const auto targetType = static_cast<Utils::TargetType>(targetTypeComponent->GetNumericValue(a_refr));
-				if (Utils::GetCurrentTarget(actor, targetType, target)) {
+				if (TargetCache::GetSingleton().GetCurrentTarget(actor, targetType, target)) {
 					return target;
 				}
 			}
@@ -3503,7 +3451,7 @@ namespace Conditions
 			if (const auto actor = a_refr->As<RE::Actor>()) {
 				RE::TESObjectREFRPtr target = nullptr;
 				const auto targetType = static_cast<Utils::TargetType>(targetTypeComponent->GetNumericValue(a_refr));
-				if (Utils::GetCurrentTarget(actor, targetType, target)) {
+				if (TargetCache::GetSingleton().GetCurrentTarget(actor, targetType, target)) {
 					return target;
 				}
 			}
@@ -3535,7 +3483,7 @@ namespace Conditions
 	{
 		if (a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				return std::to_string(Actor_GetLightLevel(actor)).data();
+				return std::to_string(ActorFactCache::GetSingleton().GetLightLevel(actor)).data();
 			}
 		}
 
@@ -3546,7 +3494,7 @@ namespace Conditions
 	{
 		if (a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				return comparisonComponent->GetComparisonResult(Actor_GetLightLevel(actor), numericComponent->GetNumericValue(a_refr));
+				return comparisonComponent->GetComparisonResult(ActorFactCache::GetSingleton().GetLightLevel(actor), numericComponent->GetNumericValue(a_refr));
 			}
 		}
 
@@ -4136,9 +4084,7 @@ namespace Conditions
 	{
 		if (a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				if (const auto charController = actor->GetCharController()) {
-					return charController->flags.any(RE::CHARACTER_FLAGS::kOnStairs);
-				}
+				return ActorFactCache::GetSingleton().IsOnStairs(actor);
 			}
 		}
 
@@ -4297,10 +4243,7 @@ namespace Conditions
 	{
 		if (a_refr) {
 			if (const auto actor = a_refr->As<RE::Actor>()) {
-				if (const auto charController = actor->GetCharController()) {
-					a_outMaterialID = *SKSE::stl::adjust_pointer<RE::MATERIAL_ID>(charController, 0x304);
-					return true;
-				}
+				return ActorFactCache::GetSingleton().GetSurfaceMaterial(actor, a_outMaterialID);
 			}
 		}
 
@@ -4539,33 +4482,9 @@ namespace Conditions
 		if (formComponent->IsValid() && a_refr) {
 			if (const auto magicEffect = formComponent->GetTESFormValue()->As<RE::EffectSetting>()) {
 				if (const auto actor = a_refr->As<RE::Actor>()) {
-					const auto magicTarget = actor->AsMagicTarget();
-
-					const auto matchesEffect = [&](RE::ActiveEffect* ae) -> bool {
-						return ae && !ae->flags.any(RE::ActiveEffect::Flag::kInactive) && ae->GetBaseObject() == magicEffect;
-					};
-
-					if (REL::Module::IsVR()) {  // VR must use a visitor since it doesn't have GetActiveEffectList
-						bool bHasEffect = false;
-						float elapsedSeconds = 0.f;
-						magicTarget->VisitActiveEffects([&](RE::ActiveEffect* ae) {
-							if (matchesEffect(ae)) {
-								bHasEffect = true;
-								elapsedSeconds = ae->elapsedSeconds;
-								return RE::BSContainer::ForEachResult::kStop;
-							}
-							return RE::BSContainer::ForEachResult::kContinue;
-						});
-						if (bHasEffect) {
-							return std::to_string(elapsedSeconds).data();
-						}
-					} else {
-						if (auto activeEffects = magicTarget->GetActiveEffectList()) {
-							for (RE::ActiveEffect* activeEffect : *activeEffects) {
-								if (matchesEffect(activeEffect)) {
-									return std::to_string(activeEffect->elapsedSeconds).data();
-								}
-							}
+					if (const auto snapshot = ActiveEffectSnapshots::GetSingleton().Get(actor)) {
+						if (const auto effects = snapshot->GetEffects(magicEffect->GetFormID()); !effects.empty()) {
+							return std::to_string(effects.front().second).data();
 						}
 					}
 				}
@@ -4580,28 +4499,10 @@ namespace Conditions
 		if (formComponent->IsValid() && a_refr) {
 			if (const auto magicEffect = formComponent->GetTESFormValue()->As<RE::EffectSetting>()) {
 				if (const auto actor = a_refr->As<RE::Actor>()) {
-					const auto magicTarget = actor->AsMagicTarget();
-
-					const auto matchesEffect = [&](RE::ActiveEffect* ae) -> bool {
-						return ae && !ae->flags.any(RE::ActiveEffect::Flag::kInactive) && ae->GetBaseObject() == magicEffect && comparisonComponent->GetComparisonResult(ae->elapsedSeconds, numericComponent->GetNumericValue(a_refr));
-					};
-
-					if (REL::Module::IsVR()) {  // VR must use a visitor since it doesn't have GetActiveEffectList
-						bool bHasEffect = false;
-						magicTarget->VisitActiveEffects([&](RE::ActiveEffect* ae) {
-							if (matchesEffect(ae)) {
-								bHasEffect = true;
-								return RE::BSContainer::ForEachResult::kStop;
-							}
-							return RE::BSContainer::ForEachResult::kContinue;
-						});
-						return bHasEffect;
-					} else {
-						if (auto activeEffects = magicTarget->GetActiveEffectList()) {
-							for (RE::ActiveEffect* activeEffect : *activeEffects) {
-								if (matchesEffect(activeEffect)) {
-									return true;
-								}
+					if (const auto snapshot = ActiveEffectSnapshots::GetSingleton().Get(actor)) {
+						for (const auto& [effectID, elapsedSeconds] : snapshot->GetEffects(magicEffect->GetFormID())) {
+							if (comparisonComponent->GetComparisonResult(elapsedSeconds, numericComponent->GetNumericValue(a_refr))) {
+								return true;
 							}
 						}
 					}
@@ -66,6 +66,23 @@ void StateDataContainerEntry::AddActiveClip(std::shared_ptr<ActiveClip>& a_activ
 	}
 }
 
+void SnapshotReclaimer::Update()
+{
+	std::vector<std::shared_ptr<const void>> expiredObjects;
+
+	{
+		Locker locker(_lock);
+
+		++_frame;
+		while (!_retiredObjects.empty() && _frame - _retiredObjects.front().first >= gracePeriodFrames) {
+			expiredObjects.emplace_back(std::move(_retiredObjects.front().second));
+			_retiredObjects.pop_front();
+		}
+	}
+
+	// expiredObjects are deleted here, outside of the lock
+}
+
 void IStateDataContainerHolder::RegisterStateDataContainer()
 {
 	OpenAnimationReplacer::GetSingleton().RegisterStateData(this);
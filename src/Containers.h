@@ -11,6 +11,240 @@
 class ActiveClip;
 class SubMod;
 
+// holds objects that were replaced or removed but might still be read without a lock by threads evaluating conditions, deletes them after a grace period of a few frames
+class SnapshotReclaimer
+{
+public:
+	static SnapshotReclaimer& GetSingleton()
+	{
+		static SnapshotReclaimer singleton;
+		return singleton;
+	}
+
+	template <typename T>
+	void Retire(std::unique_ptr<T> a_object)
+	{
+		if (!a_object) {
+			return;
+		}
+
+		Locker locker(_lock);
+		_retiredObjects.emplace_back(_frame, std::shared_ptr<const void>(std::move(a_object)));
+	}
+
+	template <typename T>
+	void Retire(std::shared_ptr<T> a_object)
+	{
+		if (!a_object) {
+			return;
+		}
+
+		Locker locker(_lock);
+		_retiredObjects.emplace_back(_frame, std::shared_ptr<const void>(std::move(a_object)));
+	}
+
+	// called once per frame on the main thread
+	void Update();
+
+private:
+	SnapshotReclaimer() = default;
+	SnapshotReclaimer(const SnapshotReclaimer&) = delete;
+	SnapshotReclaimer(SnapshotReclaimer&&) = delete;
+	virtual ~SnapshotReclaimer() = default;
+
+	SnapshotReclaimer& operator=(const SnapshotReclaimer&) = delete;
+	SnapshotReclaimer& operator=(SnapshotReclaimer&&) = delete;
+
+	// evaluations don't span frames, so nothing can still be reading an object retired this many frames ago
+	static constexpr uint32_t gracePeriodFrames = 3;
+
+	ExclusiveLock _lock;
+	std::deque<std::pair<uint32_t, std::shared_ptr<const void>>> _retiredObjects;
+	uint32_t _frame = 0;
+};
+
+// pointer keyed open addressing table that can be read without a lock. Writes have to be serialized by the owner.
+// removed entries are kept as tombstones until the table is rebuilt, the previous storage is retired to the SnapshotReclaimer so in-flight lookups stay valid
+template <typename Key, typename Value>
+class PointerLookupTable
+{
+public:
+	PointerLookupTable() :
+		_storage(new Storage(minCapacity)) {}
+
+	~PointerLookupTable() { delete _storage.load(); }
+
+	PointerLookupTable(const PointerLookupTable&) = delete;
+	PointerLookupTable(PointerLookupTable&&) = delete;
+	PointerLookupTable& operator=(const PointerLookupTable&) = delete;
+	PointerLookupTable& operator=(PointerLookupTable&&) = delete;
+
+	[[nodiscard]] Value* Find(const Key* a_key) const
+	{
+		const auto storage = _storage.load(std::memory_order_acquire);
+
+		size_t index = storage->GetIndex(a_key);
+		for (size_t i = 0; i < storage->capacity; ++i) {
+			const auto& slot = storage->slots[index];
+			const auto key = slot.key.load(std::memory_order_acquire);
+			if (key == a_key) {
+				return slot.value.load(std::memory_order_acquire);
+			}
+			if (key == nullptr) {
+				return nullptr;
+			}
+			index = (index + 1) & (storage->capacity - 1);
+		}
+
+		return nullptr;
+	}
+
+	// writer only
+	void Insert(const Key* a_key, Value* a_value)
+	{
+		auto storage = _storage.load(std::memory_order_relaxed);
+		if (const auto slot = storage->FindSlot(a_key)) {
+			if (slot->key.load(std::memory_order_relaxed) == a_key) {
+				if (!slot->value.load(std::memory_order_relaxed)) {
+					++_liveCount;
+				}
+				slot->value.store(a_value, std::memory_order_release);
+				return;
+			}
+		}
+
+		// keep the load factor including tombstones under a half so probe sequences stay short
+		if ((storage->usedSlots + 1) * 2 > storage->capacity) {
+			Rebuild();
+			storage = _storage.load(std::memory_order_relaxed);
+		}
+
+		storage->Add(a_key, a_value);
+		++_liveCount;
+	}
+
+	// writer only
+	void Erase(const Key* a_key)
+	{
+		const auto storage = _storage.load(std::memory_order_relaxed);
+		if (const auto slot = storage->FindSlot(a_key); slot && slot->key.load(std::memory_order_relaxed) == a_key) {
+			if (slot->value.exchange(nullptr, std::memory_order_release)) {
+				--_liveCount;
+			}
+		}
+	}
+
+private:
+	static constexpr size_t minCapacity = 4096;
+
+	struct Slot
+	{
+		std::atomic<const Key*> key = nullptr;
+		std::atomic<Value*> value = nullptr;
+	};
+
+	struct Storage
+	{
+		explicit Storage(size_t a_capacity) :
+			slots(std::make_unique<Slot[]>(a_capacity)), capacity(a_capacity), shift(64 - std::countr_zero(a_capacity)) {}
+
+		[[nodiscard]] size_t GetIndex(const Key* a_key) const
+		{
+			// fibonacci hashing, the low bits of the pointers are always zero
+			return static_cast<size_t>((reinterpret_cast<uint64_t>(a_key) * 0x9E3779B97F4A7C15ull) >> shift);
+		}
+
+		// returns the slot of the key, or the empty slot it would go in
+		[[nodiscard]] Slot* FindSlot(const Key* a_key) const
+		{
+			size_t index = GetIndex(a_key);
+			for (size_t i = 0; i < capacity; ++i) {
+				auto& slot = slots[index];
+				const auto key = slot.key.load(std::memory_order_relaxed);
+				if (key == a_key || key == nullptr) {
+					return &slot;
+				}
+				index = (index + 1) & (capacity - 1);
+			}
+
+			return nullptr;
+		}
+
+		void Add(const Key* a_key, Value* a_value)
+		{
+			auto slot = FindSlot(a_key);
+			// the value has to be visible before the key is
+			slot->value.store(a_value, std::memory_order_relaxed);
+			slot->key.store(a_key, std::memory_order_release);
+			++usedSlots;
+		}
+
+		std::unique_ptr<Slot[]> slots;
+		size_t capacity;
+		int shift;
+		size_t usedSlots = 0;
+	};
+
+	void Rebuild()
+	{
+		const auto oldStorage = _storage.load(std::memory_order_relaxed);
+		const auto newStorage = new Storage(std::max(minCapacity, std::bit_ceil(_liveCount * 4)));
+
+		for (size_t i = 0; i < oldStorage->capacity; ++i) {
+			const auto& slot = oldStorage->slots[i];
+			if (const auto value = slot.value.load(std::memory_order_relaxed)) {
+				newStorage->Add(slot.key.load(std::memory_order_relaxed), value);
+			}
+		}
+
+		_storage.store(newStorage, std::memory_order_release);
+		SnapshotReclaimer::GetSingleton().Retire(std::unique_ptr<Storage>(oldStorage));
+	}
+
+	std::atomic<Storage*> _storage;
+	size_t _liveCount = 0;
+};
+
+// fixed capacity vector stored inline, adding to a full one drops the oldest element
+template <typename T, size_t Capacity>
+class BoundedVector
+{
+public:
+	[[nodiscard]] bool empty() const { return _size == 0; }
+	[[nodiscard]] size_t size() const { return _size; }
+
+	[[nodiscard]] T* begin() { return _items.data(); }
+	[[nodiscard]] T* end() { return _items.data() + _size; }
+	[[nodiscard]] const T* begin() const { return _items.data(); }
+	[[nodiscard]] const T* end() const { return _items.data() + _size; }
+
+	[[nodiscard]] T& front() { return _items[0]; }
+	[[nodiscard]] T& back() { return _items[_size - 1]; }
+	[[nodiscard]] const T& front() const { return _items[0]; }
+	[[nodiscard]] const T& back() const { return _items[_size - 1]; }
+
+	T& emplace_back(T&& a_item)
+	{
+		if (_size == Capacity) {
+			erase(begin());
+		}
+
+		_items[_size] = std::move(a_item);
+		return _items[_size++];
+	}
+
+	T* erase(T* a_it)
+	{
+		std::move(a_it + 1, end(), a_it);
+		_items[--_size] = T{};
+		return a_it;
+	}
+
+private:
+	std::array<T, Capacity> _items{};
+	size_t _size = 0;
+};
+
 template <typename T, typename Derived>
 class Set
 {
@@ -22,6 +256,16 @@ public:
 	Set(SubMod* a_parentSubMod) :
 		_parentSubMod(a_parentSubMod) {}
 
+	~Set()
+	{
+		delete _snapshot.load();
+	}
+
+	Set(const Set&) = delete;
+	Set(Set&&) = delete;
+	Set& operator=(const Set&) = delete;
+	Set& operator=(Set&&) = delete;
+
 	bool IsEmpty() const { return _entries.empty(); }
 
 	bool IsDirty() const { return _bDirty; }
@@ -60,6 +304,16 @@ public:
 		return result;
 	}
 
+	// lock-free view of the entries for the evaluation path, stays valid for a few frames after the set is edited
+	[[nodiscard]] std::span<T* const> GetSnapshot() const
+	{
+		if (const auto snapshot = _snapshot.load(std::memory_order_acquire)) {
+			return *snapshot;
+		}
+
+		return {};
+	}
+
 	void Add(std::unique_ptr<T>& a_object, bool a_bSetDirty = false)
 	{
 		if (!a_object) {
@@ -70,6 +324,7 @@ public:
 			WriteLocker locker(_lock);
 			auto& entry = _entries.emplace_back(std::move(a_object));
 			SetAsParent(entry);
+			PublishSnapshot();
 		}
 
 		if (a_bSetDirty) {
@@ -85,7 +340,11 @@ public:
 
 		{
 			WriteLocker locker(_lock);
-			std::erase(_entries, a_object);
+			if (const auto it = std::ranges::find(_entries, a_object); it != _entries.end()) {
+				SnapshotReclaimer::GetSingleton().Retire(std::move(*it));
+				_entries.erase(it);
+			}
+			PublishSnapshot();
 		}
 
 		SetDirty(true);
@@ -102,6 +361,7 @@ public:
 
 		auto extracted = std::move(a_object);
 		std::erase(_entries, a_object);
+		PublishSnapshot();
 
 		return extracted;
 	}
@@ -122,12 +382,14 @@ public:
 			if (const auto it = std::ranges::find(_entries, a_insertAfter); it != _entries.end()) {
 				const auto entry = _entries.insert(it + 1, std::move(a_objectToInsert));
 				SetAsParent(*entry);
+				PublishSnapshot();
 				return;
 			}
 		}
 
 		auto& entry = _entries.emplace_back(std::move(a_objectToInsert));
 		SetAsParent(entry);
+		PublishSnapshot();
 	}
 
 	void Replace(std::unique_ptr<T>& a_objectToSubstitute, std::unique_ptr<T>& a_newObject)
@@ -142,7 +404,9 @@ public:
 
 		{
 			WriteLocker locker(_lock);
+			SnapshotReclaimer::GetSingleton().Retire(std::move(a_objectToSubstitute));
 			a_objectToSubstitute = std::move(a_newObject);
+			PublishSnapshot();
 		}
 
 		SetDirty(true);
@@ -181,6 +445,7 @@ public:
 			auto extractedObject = std::move(a_sourceObject);
 			_entries.erase(_entries.begin() + sourceIndex);
 			_entries.insert(_entries.begin() + targetIndex, std::move(extractedObject));
+			PublishSnapshot();
 
 			SetDirty(true);
 		} else {
@@ -206,6 +471,7 @@ public:
 				auto& entry = _entries.emplace_back(std::move(extractedObject));
 				SetAsParent(entry);
 			}
+			PublishSnapshot();
 
 			SetDirty(true);
 		}
@@ -220,7 +486,15 @@ public:
 			return RE::BSVisit::BSVisitControl::kContinue;
 		});
 
+		for (auto& entry : _entries) {
+			SnapshotReclaimer::GetSingleton().Retire(std::move(entry));
+		}
+
+		WriteLocker otherLocker(a_otherSet->_lock);
+
 		_entries = std::move(a_otherSet->_entries);
+		PublishSnapshot();
+		a_otherSet->PublishSnapshot();
 	}
 
 	void Append(Set<T, Derived>* a_otherSet)
@@ -237,6 +511,8 @@ public:
 		_entries.reserve(_entries.size() + a_otherSet->_entries.size());
 
 		_entries.insert(_entries.end(), std::make_move_iterator(a_otherSet->_entries.begin()), std::make_move_iterator(a_otherSet->_entries.end()));
+		PublishSnapshot();
+		a_otherSet->PublishSnapshot();
 
 		SetDirty(true);
 	}
@@ -245,7 +521,11 @@ public:
 	{
 		{
 			WriteLocker locker(_lock);
+			for (auto& entry : _entries) {
+				SnapshotReclaimer::GetSingleton().Retire(std::move(entry));
+			}
 			_entries.clear();
+			PublishSnapshot();
 		}
 
 		SetDirty(true);
@@ -314,8 +594,33 @@ public:
 	}
 
 protected:
+	// builds a new immutable list of the entries for GetSnapshot, must be called with the write lock held after every edit.
+	// the previous list might still be read by evaluating threads so its deletion is deferred
+	void PublishSnapshot()
+	{
+		auto snapshot = std::make_unique<std::vector<T*>>();
+		snapshot->reserve(_entries.size());
+		for (const auto& entry : _entries) {
+			if (entry) {
+				snapshot->push_back(entry.get());
+			}
+		}
+
+		if (const auto previousSnapshot = _snapshot.exchange(snapshot.release(), std::memory_order_acq_rel)) {
+			SnapshotReclaimer::GetSingleton().Retire(std::unique_ptr<const std::vector<T*>>(previousSnapshot));
+		}
+
+		static_cast<Derived*>(this)->OnSnapshotPublishedImpl();
+	}
+
+	// lets derived sets drop anything built from the previous entries
+	void OnSnapshotPublishedImpl()
+	{
+	}
+
 	mutable SharedLock _lock;
 	std::vector<std::unique_ptr<T>> _entries;
+	std::atomic<const std::vector<T*>*> _snapshot = nullptr;
 	std::vector<Callback> _onDirtyCallbacks;
 	bool _bDirty = false;
 
@@ -0,0 +1,75 @@
+#include "EventHandler.h"
+
+#include "ActiveEffectSnapshot.h"
+#include "ActorFacts.h"
+#include "InventoryCache.h"
+#include "OpenAnimationReplacer.h"
+
+void EventHandler::Register()
+{
+	if (const auto scriptEventSourceHolder = RE::ScriptEventSourceHolder::GetSingleton()) {
+		auto& eventHandler = GetSingleton();
+		scriptEventSourceHolder->AddEventSink<RE::TESEquipEvent>(&eventHandler);
+		scriptEventSourceHolder->AddEventSink<RE::TESCombatEvent>(&eventHandler);
+		scriptEventSourceHolder->AddEventSink<RE::TESActiveEffectApplyRemoveEvent>(&eventHandler);
+		scriptEventSourceHolder->AddEventSink<RE::TESObjectLoadedEvent>(&eventHandler);
+		scriptEventSourceHolder->AddEventSink<RE::TESContainerChangedEvent>(&eventHandler);
+		logger::info("Registered event handler");
+	}
+}
+
+RE::BSEventNotifyControl EventHandler::ProcessEvent(const RE::TESEquipEvent* a_event, [[maybe_unused]] RE::BSTEventSource<RE::TESEquipEvent>* a_eventSource)
+{
+	if (a_event && a_event->actor) {
+		OpenAnimationReplacer::GetSingleton().OnConditionDependencyChanged(a_event->actor.get(), Utils::ConditionDependency::kEquipment);
+		OpenAnimationReplacer::GetSingleton().ClearNoMatchCache(a_event->actor.get());
+		InventoryCache::GetSingleton().Invalidate(a_event->actor.get());
+	}
+
+	return RE::BSEventNotifyControl::kContinue;
+}
+
+RE::BSEventNotifyControl EventHandler::ProcessEvent(const RE::TESCombatEvent* a_event, [[maybe_unused]] RE::BSTEventSource<RE::TESCombatEvent>* a_eventSource)
+{
+	if (a_event && a_event->actor) {
+		OpenAnimationReplacer::GetSingleton().OnConditionDependencyChanged(a_event->actor.get(), Utils::ConditionDependency::kCombat);
+		ActorFactCache::GetSingleton().Invalidate(a_event->actor.get());
+	}
+
+	return RE::BSEventNotifyControl::kContinue;
+}
+
+RE::BSEventNotifyControl EventHandler::ProcessEvent(const RE::TESActiveEffectApplyRemoveEvent* a_event, [[maybe_unused]] RE::BSTEventSource<RE::TESActiveEffectApplyRemoveEvent>* a_eventSource)
+{
+	if (a_event && a_event->target) {
+		OpenAnimationReplacer::GetSingleton().OnConditionDependencyChanged(a_event->target.get(), Utils::ConditionDependency::kMagicEffects);
+		// effects applied or removed during this frame wouldn't be in a snapshot built earlier in the frame
+		ActiveEffectSnapshots::GetSingleton().Invalidate(a_event->target.get());
+	}
+
+	return RE::BSEventNotifyControl::kContinue;
+}
+
+RE::BSEventNotifyControl EventHandler::ProcessEvent(const RE::TESObjectLoadedEvent* a_event, [[maybe_unused]] RE::BSTEventSource<RE::TESObjectLoadedEvent>* a_eventSource)
+{
+	if (a_event) {
+		// only actors have clips, cell loads fire this for every static too
+		if (const auto actor = RE::TESForm::LookupByID<RE::Actor>(a_event->formID)) {
+			OpenAnimationReplacer::GetSingleton().ClearNoMatchCache(actor);
+			InventoryCache::GetSingleton().Invalidate(actor);
+		}
+	}
+
+	return RE::BSEventNotifyControl::kContinue;
+}
+
+RE::BSEventNotifyControl EventHandler::ProcessEvent(const RE::TESContainerChangedEvent* a_event, [[maybe_unused]] RE::BSTEventSource<RE::TESContainerChangedEvent>* a_eventSource)
+{
+	if (a_event) {
+		auto& inventoryCache = InventoryCache::GetSingleton();
+		inventoryCache.Invalidate(RE::TESForm::LookupByID<RE::TESObjectREFR>(a_event->oldContainer));
+		inventoryCache.Invalidate(RE::TESForm::LookupByID<RE::TESObjectREFR>(a_event->newContainer));
+	}
+
+	return RE::BSEventNotifyControl::kContinue;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// listens to game events that invalidate results of conditions evaluated earlier
+class EventHandler :
+	public RE::BSTEventSink<RE::TESEquipEvent>,
+	public RE::BSTEventSink<RE::TESCombatEvent>,
+	public RE::BSTEventSink<RE::TESActiveEffectApplyRemoveEvent>,
+	public RE::BSTEventSink<RE::TESObjectLoadedEvent>,
+	public RE::BSTEventSink<RE::TESContainerChangedEvent>
+{
+public:
+	static EventHandler& GetSingleton()
+	{
+		static EventHandler singleton;
+		return singleton;
+	}
+
+	static void Register();
+
+	// override BSTEventSink
+	RE::BSEventNotifyControl ProcessEvent(const RE::TESEquipEvent* a_event, RE::BSTEventSource<RE::TESEquipEvent>* a_eventSource) override;
+	RE::BSEventNotifyControl ProcessEvent(const RE::TESCombatEvent* a_event, RE::BSTEventSource<RE::TESCombatEvent>* a_eventSource) override;
+	RE::BSEventNotifyControl ProcessEvent(const RE::TESActiveEffectApplyRemoveEvent* a_event, RE::BSTEventSource<RE::TESActiveEffectApplyRemoveEvent>* a_eventSource) override;
+	RE::BSEventNotifyControl ProcessEvent(const RE::TESObjectLoadedEvent* a_event, RE::BSTEventSource<RE::TESObjectLoadedEvent>* a_eventSource) override;
+	RE::BSEventNotifyControl ProcessEvent(const RE::TESContainerChangedEvent* a_event, RE::BSTEventSource<RE::TESContainerChangedEvent>* a_eventSource) override;
+
+private:
+	EventHandler() = default;
+	EventHandler(const EventHandler&) = delete;
+	EventHandler(EventHandler&&) = delete;
+	virtual ~EventHandler() = default;
+
+	EventHandler& operator=(const EventHandler&) = delete;
+	EventHandler& operator=(EventHandler&&) = delete;
+};
@@ -0,0 +1,94 @@
+#include "FrameStats.h"
+
+uint64_t FrameStats::Frame::GetTotalNanoseconds() const
+{
+	uint64_t total = 0;
+	for (const auto nanoseconds : phaseNanoseconds) {
+		total += nanoseconds;
+	}
+
+	return total;
+}
+
+void FrameStats::ScopedTimer::Pause()
+{
+	if (_startTime != 0) {
+		FrameStats::GetSingleton().AddTime(_phase, Now() - _startTime);
+		_startTime = 0;
+	}
+}
+
+void FrameStats::ScopedTimer::Resume()
+{
+	if (IsEnabled()) {
+		_startTime = Now();
+	}
+}
+
+std::string_view FrameStats::GetPhaseName(Phase a_phase)
+{
+	switch (a_phase) {
+	case Phase::kActivate:
+		return "Activate"sv;
+	case Phase::kUpdate:
+		return "Update"sv;
+	case Phase::kGenerate:
+		return "Generate"sv;
+	case Phase::kDeactivate:
+		return "Deactivate"sv;
+	case Phase::kNullsub:
+		return "Nullsub"sv;
+	}
+
+	return ""sv;
+}
+
+std::string_view FrameStats::GetCounterName(Counter a_counter)
+{
+	switch (a_counter) {
+	case Counter::kClipActivations:
+		return "Clip activations"sv;
+	case Counter::kEvaluations:
+		return "Evaluations"sv;
+	case Counter::kInterruptibleEvaluations:
+		return "Interruptible evaluations"sv;
+	}
+
+	return ""sv;
+}
+
+void FrameStats::EndFrame()
+{
+	if (!IsEnabled()) {
+		return;
+	}
+
+	Frame frame;
+	for (size_t i = 0; i < phaseCount; ++i) {
+		frame.phaseNanoseconds[i] = _currentPhaseNanoseconds[i].exchange(0, std::memory_order_relaxed);
+	}
+	for (size_t i = 0; i < counterCount; ++i) {
+		frame.counters[i] = _currentCounters[i].exchange(0, std::memory_order_relaxed);
+	}
+
+	Locker locker(_framesLock);
+
+	_frames[_nextFrameIndex] = frame;
+	_nextFrameIndex = (_nextFrameIndex + 1) % frameCount;
+	_storedFrameCount = std::min(_storedFrameCount + 1, frameCount);
+}
+
+std::vector<FrameStats::Frame> FrameStats::GetFrames() const
+{
+	Locker locker(_framesLock);
+
+	std::vector<Frame> frames;
+	frames.reserve(_storedFrameCount);
+
+	const size_t firstIndex = (_nextFrameIndex + frameCount - _storedFrameCount) % frameCount;
+	for (size_t i = 0; i < _storedFrameCount; ++i) {
+		frames.emplace_back(_frames[(firstIndex + i) % frameCount]);
+	}
+
+	return frames;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Settings.h"
+
+// per-frame accounting of the time spent in the havok hooks, kept for the last frames to be shown in the frame budget overlay
+class FrameStats final
+{
+public:
+	static FrameStats& GetSingleton()
+	{
+		static FrameStats singleton;
+		return singleton;
+	}
+
+	enum class Phase : uint8_t
+	{
+		kActivate,
+		kUpdate,
+		kGenerate,
+		kDeactivate,
+		kNullsub,
+
+		kTotal
+	};
+
+	enum class Counter : uint8_t
+	{
+		kClipActivations,
+		kEvaluations,
+		kInterruptibleEvaluations,
+
+		kTotal
+	};
+
+	static constexpr size_t phaseCount = static_cast<size_t>(Phase::kTotal);
+	static constexpr size_t counterCount = static_cast<size_t>(Counter::kTotal);
+	static constexpr size_t frameCount = 240;
+
+	struct Frame
+	{
+		std::array<uint64_t, phaseCount> phaseNanoseconds{};
+		std::array<uint32_t, counterCount> counters{};
+
+		[[nodiscard]] uint64_t GetTotalNanoseconds() const;
+	};
+
+	// adds the time until destroyed to a phase of the current frame, excluding the time between Pause and Resume (e.g. the original function)
+	class ScopedTimer
+	{
+	public:
+		explicit ScopedTimer(Phase a_phase) :
+			_phase(a_phase), _startTime(IsEnabled() ? Now() : 0) {}
+
+		~ScopedTimer() { Pause(); }
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer(ScopedTimer&&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(ScopedTimer&&) = delete;
+
+		void Pause();
+		void Resume();
+
+	private:
+		Phase _phase;
+		uint64_t _startTime;
+	};
+
+	[[nodiscard]] static bool IsEnabled() { return Settings::bShowFrameStatsOverlay; }
+	[[nodiscard]] static uint64_t Now() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+	[[nodiscard]] static std::string_view GetPhaseName(Phase a_phase);
+	[[nodiscard]] static std::string_view GetCounterName(Counter a_counter);
+
+	void AddTime(Phase a_phase, uint64_t a_nanoseconds) { _currentPhaseNanoseconds[static_cast<size_t>(a_phase)].fetch_add(a_nanoseconds, std::memory_order_relaxed); }
+	void Increment(Counter a_counter)
+	{
+		if (IsEnabled()) {
+			_currentCounters[static_cast<size_t>(a_counter)].fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	// called once per frame from the nullsub hook
+	void EndFrame();
+
+	// frames from oldest to newest
+	[[nodiscard]] std::vector<Frame> GetFrames() const;
+
+private:
+	FrameStats() = default;
+	FrameStats(const FrameStats&) = delete;
+	FrameStats(FrameStats&&) = delete;
+	~FrameStats() = default;
+
+	FrameStats& operator=(const FrameStats&) = delete;
+	FrameStats& operator=(FrameStats&&) = delete;
+
+	std::array<std::atomic<uint64_t>, phaseCount> _currentPhaseNanoseconds{};
+	std::array<std::atomic<uint32_t>, counterCount> _currentCounters{};
+
+	mutable ExclusiveLock _framesLock;
+	std::array<Frame, frameCount> _frames{};
+	size_t _nextFrameIndex = 0;
+	size_t _storedFrameCount = 0;
+};
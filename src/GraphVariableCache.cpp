@@ -0,0 +1,101 @@
+#include "GraphVariableCache.h"
+
+bool GraphVariableCache::GetFloat(RE::TESObjectREFR* a_refr, const RE::BSFixedString& a_name, float& a_outValue)
+{
+	if (int32_t word; ReadWord(a_refr, a_name, word)) {
+		a_outValue = std::bit_cast<float>(word);
+		return true;
+	}
+
+	return a_refr->GetGraphVariableFloat(a_name, a_outValue);
+}
+
+bool GraphVariableCache::GetInt(RE::TESObjectREFR* a_refr, const RE::BSFixedString& a_name, int32_t& a_outValue)
+{
+	if (int32_t word; ReadWord(a_refr, a_name, word)) {
+		a_outValue = word;
+		return true;
+	}
+
+	return a_refr->GetGraphVariableInt(a_name, a_outValue);
+}
+
+bool GraphVariableCache::GetBool(RE::TESObjectREFR* a_refr, const RE::BSFixedString& a_name, bool& a_outValue)
+{
+	if (int32_t word; ReadWord(a_refr, a_name, word)) {
+		a_outValue = word != 0;
+		return true;
+	}
+
+	return a_refr->GetGraphVariableBool(a_name, a_outValue);
+}
+
+void GraphVariableCache::Clear()
+{
+	WriteLocker locker(_lock);
+
+	_indices.clear();
+}
+
+bool GraphVariableCache::ReadWord(RE::TESObjectREFR* a_refr, const RE::BSFixedString& a_name, int32_t& a_outWord)
+{
+	if (!a_refr || a_name.empty()) {
+		return false;
+	}
+
+	RE::BSAnimationGraphManagerPtr graphManager = nullptr;
+	if (!a_refr->GetAnimationGraphManager(graphManager) || !graphManager || graphManager->graphs.empty()) {
+		return false;
+	}
+
+	const auto& activeGraph = graphManager->graphs[graphManager->GetRuntimeData().activeGraph];
+	if (!activeGraph || !activeGraph->behaviorGraph) {
+		return false;
+	}
+
+	const auto behaviorGraph = activeGraph->behaviorGraph;
+	const int32_t index = GetVariableIndex(behaviorGraph, a_name);
+	if (index < 0) {
+		return false;
+	}
+
+	// the value set only exists once the graph has been activated
+	const auto& valueSet = behaviorGraph->variableValueSet;
+	if (!valueSet || index >= valueSet->wordVariableValues.size()) {
+		return false;
+	}
+
+	a_outWord = *reinterpret_cast<const int32_t*>(&valueSet->wordVariableValues[index]);
+	return true;
+}
+
+int32_t GraphVariableCache::GetVariableIndex(const RE::hkbBehaviorGraph* a_behaviorGraph, const RE::BSFixedString& a_name)
+{
+	const Key key{ a_behaviorGraph, a_name.data() };
+
+	{
+		ReadLocker locker(_lock);
+
+		if (const auto it = _indices.find(key); it != _indices.end()) {
+			return it->second.index;
+		}
+	}
+
+	// the root graph's own variables come first in its value set, in the order of its data
+	int32_t index = -1;
+	if (a_behaviorGraph->data && a_behaviorGraph->data->stringData) {
+		const auto& variableNames = a_behaviorGraph->data->stringData->variableNames;
+		for (int32_t i = 0; i < variableNames.size(); ++i) {
+			if (variableNames[i].data() && _strcmpi(variableNames[i].data(), a_name.data()) == 0) {
+				index = i;
+				break;
+			}
+		}
+	}
+
+	WriteLocker locker(_lock);
+
+	_indices.try_emplace(key, a_name, index);
+
+	return index;
+}
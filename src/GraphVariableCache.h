@@ -0,0 +1,44 @@
+#pragma once
+
+// remembers where graph variables live in the value set of each behavior graph, so reading one skips the by-name lookup.
+// variables that aren't in the root behavior's own data fall back to the refr's GetGraphVariable functions
+class GraphVariableCache final
+{
+public:
+	static GraphVariableCache& GetSingleton()
+	{
+		static GraphVariableCache singleton;
+		return singleton;
+	}
+
+	// same results as the refr's GetGraphVariable functions
+	bool GetFloat(RE::TESObjectREFR* a_refr, const RE::BSFixedString& a_name, float& a_outValue);
+	bool GetInt(RE::TESObjectREFR* a_refr, const RE::BSFixedString& a_name, int32_t& a_outValue);
+	bool GetBool(RE::TESObjectREFR* a_refr, const RE::BSFixedString& a_name, bool& a_outValue);
+
+	// called whenever a behavior graph is created, a new one can reuse the address of a freed one
+	void Clear();
+
+private:
+	GraphVariableCache() = default;
+	GraphVariableCache(const GraphVariableCache&) = delete;
+	GraphVariableCache(GraphVariableCache&&) = delete;
+	~GraphVariableCache() = default;
+
+	GraphVariableCache& operator=(const GraphVariableCache&) = delete;
+	GraphVariableCache& operator=(GraphVariableCache&&) = delete;
+
+	// reads the raw word of the variable from the active graph, returns false if the fallback has to be used
+	[[nodiscard]] bool ReadWord(RE::TESObjectREFR* a_refr, const RE::BSFixedString& a_name, int32_t& a_outWord);
+	[[nodiscard]] int32_t GetVariableIndex(const RE::hkbBehaviorGraph* a_behaviorGraph, const RE::BSFixedString& a_name);
+
+	struct CachedIndex
+	{
+		RE::BSFixedString name;  // keeps the key's string alive so its address can't be reused by another name
+		int32_t index;           // -1 if the variable isn't in the graph's own data
+	};
+
+	using Key = std::pair<const RE::hkbBehaviorGraph*, const char*>;
+	mutable SharedLock _lock;
+	std::unordered_map<Key, CachedIndex, KeyHash<Key>> _indices;
+};
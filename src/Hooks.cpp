@@ -1,6 +1,9 @@
 #include "Hooks.h"
 
 #include "AnimationEventLog.h"
+#include "FrameStats.h"
+#include "GraphVariableCache.h"
+#include "InventoryCache.h"
 
 #include <xbyak/xbyak.h>
 
@@ -29,28 +32,51 @@ namespace Hooks
 
 	void HavokHooks::Nullsub()
 	{
+		FrameStats::GetSingleton().EndFrame();
+		FrameStats::ScopedTimer timer(FrameStats::Phase::kNullsub);
+
 		OpenAnimationReplacer::gameTimeCounter += g_deltaTime;
 		OpenAnimationReplacer::GetSingleton().RunJobs();
+		SnapshotReclaimer::GetSingleton().Update();
 		if (!RE::UI::GetSingleton()->GameIsPaused()) {
 			OpenAnimationReplacer::GetSingleton().RunStateDataUpdates();
+			OpenAnimationReplacer::GetSingleton().CheckGameTimeDependency();
+			OpenAnimationReplacer::GetSingleton().PurgeExpiredNoMatchCache();
+			InventoryCache::GetSingleton().PurgeInvalidEntries();
 		}
+		timer.Pause();
 		_Nullsub();
 	}
 
 	void HavokHooks::hkbClipGenerator_Activate(RE::hkbClipGenerator* a_this, const RE::hkbContext& a_context)
 	{
+		FrameStats::ScopedTimer timer(FrameStats::Phase::kActivate);
+		FrameStats::GetSingleton().Increment(FrameStats::Counter::kClipActivations);
+
+		auto& openAnimationReplacer = OpenAnimationReplacer::GetSingleton();
+		auto& animationLog = AnimationLog::GetSingleton();
+
+		// don't create an active clip when there is nothing to replace and the animation log isn't watching, the other hooks won't find one and return early
+		// the clip might already be active if it's transitioning or synchronized
+		if (!openAnimationReplacer.HasReplacements(a_context.character, a_this->animationBindingIndex) && !animationLog.ShouldLogAnimations() && !openAnimationReplacer.GetActiveClip(a_this)) {
+			timer.Pause();
+			_hkbClipGenerator_Activate(a_this, a_context);
+			return;
+		}
+
 		bool bAdded;
-		const auto activeClip = OpenAnimationReplacer::GetSingleton().AddOrGetActiveClip(a_this, a_context, bAdded);
+		const auto activeClip = openAnimationReplacer.AddOrGetActiveClip(a_this, a_context, bAdded);
 
 		activeClip->OnActivate(a_this, a_context);
 
-		auto& animationLog = AnimationLog::GetSingleton();
 		const auto event = activeClip->IsOriginal() ? AnimationLogEntry::Event::kActivate : AnimationLogEntry::Event::kActivateReplace;
 		if (bAdded && !activeClip->IsTransitioning() && animationLog.ShouldLogAnimationsForActiveClip(activeClip, event)) {
 			animationLog.LogAnimation(event, activeClip, a_context.character);
 		}
 
+		timer.Pause();
 		_hkbClipGenerator_Activate(a_this, a_context);
+		timer.Resume();
 
 		activeClip->OnPostActivate(a_this, a_context);
 
@@ -61,16 +87,21 @@ namespace Hooks
 
 	void HavokHooks::hkbClipGenerator_Update(RE::hkbClipGenerator* a_this, const RE::hkbContext& a_context, float a_timestep)
 	{
+		FrameStats::ScopedTimer timer(FrameStats::Phase::kUpdate);
+
 		const auto activeClip = OpenAnimationReplacer::GetSingleton().GetActiveClip(a_this);
 		if (activeClip) {
 			activeClip->PreUpdate(a_this, a_context, a_timestep);
 		}
 
+		timer.Pause();
 		_hkbClipGenerator_Update(a_this, a_context, a_timestep);
 	}
 
 	void HavokHooks::hkbClipGenerator_Deactivate(RE::hkbClipGenerator* a_this, const RE::hkbContext& a_context)
 	{
+		FrameStats::ScopedTimer timer(FrameStats::Phase::kDeactivate);
+
 		auto& openAnimationReplacer = OpenAnimationReplacer::GetSingleton();
 
 		if (openAnimationReplacer.HasActiveAnimationPreviews()) {
@@ -82,25 +113,32 @@ namespace Hooks
 			activeClip->OnDeactivate(a_this, a_context);
 		}
 
+		timer.Pause();
 		_hkbClipGenerator_Deactivate(a_this, a_context);
+		timer.Resume();
 
 		openAnimationReplacer.RemoveActiveClip(a_this);
 	}
 
 	void HavokHooks::hkbClipGenerator_Generate(RE::hkbClipGenerator* a_this, const RE::hkbContext& a_context, const RE::hkbGeneratorOutput** a_activeChildrenOutput, RE::hkbGeneratorOutput& a_output, float a_timeOffset)
 	{
+		FrameStats::ScopedTimer timer(FrameStats::Phase::kGenerate);
+
 		const auto activeClip = OpenAnimationReplacer::GetSingleton().GetActiveClip(a_this);
 		if (activeClip && activeClip->IsBlending()) {
 			//activeClip->PreGenerate(a_this, a_context, a_output);
 
 			// if the animation is not fully loaded yet, call generate with our fake clip generator containing the previous animation instead - this avoids seeing the reference pose for a frame
 			if (a_this->userData != 0xC) {
+				timer.Pause();
 				_hkbClipGenerator_Generate(activeClip->GetLastBlendingClipGenerator(), a_context, a_activeChildrenOutput, a_output, a_timeOffset);
 				return;
 			}
 		}
 
+		timer.Pause();
 		_hkbClipGenerator_Generate(a_this, a_context, a_activeChildrenOutput, a_output, a_timeOffset);
+		timer.Resume();
 
 		if (activeClip) {
 			activeClip->OnGenerate(a_this, a_context, a_output);
@@ -247,6 +285,9 @@ namespace Hooks
 
 	RE::hkbSymbolIdMap* HavokHooks::CreateSymbolIdMap(RE::hkbBehaviorGraph* a_this, const RE::BSScrapArray<RE::hkbBehaviorGraph*>& a_graphArr, const char* a_projectPath, RE::hkbCharacter* a_character, RE::hkbSymbolLinker* a_eventLinker, RE::hkbSymbolLinker* a_variableLinker)
 	{
+		// a new graph might reuse the address of a freed one
+		GraphVariableCache::GetSingleton().Clear();
+
 		if (a_this && a_character && a_this->data && !a_this->eventIDMap) {
 			// inject event
 			for (auto& graph : a_graphArr) {
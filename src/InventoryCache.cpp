@@ -0,0 +1,79 @@
+#include "InventoryCache.h"
+
+#include "OpenAnimationReplacer.h"
+#include "Settings.h"
+
+Utils::InventoryItemInfo InventoryCache::GetItemInfo(RE::TESObjectREFR* a_refr, RE::FormID a_formID)
+{
+	if (!Settings::bCacheInventoryQueries || !a_refr) {
+		return Utils::GetInventoryItemInfo(a_refr, a_formID);
+	}
+
+	const auto refrFormID = a_refr->GetFormID();
+
+	uint64_t generation = 0;
+	{
+		ReadLocker locker(_lock);
+
+		generation = _generation;
+		if (const auto refrIt = _cache.find(a_refr); refrIt != _cache.end() && refrIt->second.formID == refrFormID) {
+			if (const auto formIt = refrIt->second.items.find(a_formID); formIt != refrIt->second.items.end()) {
+				return formIt->second;
+			}
+		}
+	}
+
+	const auto info = Utils::GetInventoryItemInfo(a_refr, a_formID);
+
+	WriteLocker locker(_lock);
+
+	// an inventory changed while we were reading this one, the result might already be stale
+	if (generation != _generation) {
+		return info;
+	}
+
+	auto& refrEntry = _cache[a_refr];
+	if (refrEntry.formID != refrFormID) {
+		refrEntry.formID = refrFormID;
+		refrEntry.items.clear();
+	}
+	refrEntry.items[a_formID] = info;
+
+	return info;
+}
+
+void InventoryCache::Invalidate(RE::TESObjectREFR* a_refr)
+{
+	if (!Settings::bCacheInventoryQueries || !a_refr) {
+		return;
+	}
+
+	WriteLocker locker(_lock);
+
+	++_generation;
+	_cache.erase(a_refr);
+}
+
+void InventoryCache::Clear()
+{
+	WriteLocker locker(_lock);
+
+	++_generation;
+	_cache.clear();
+}
+
+void InventoryCache::PurgeInvalidEntries()
+{
+	if (OpenAnimationReplacer::gameTimeCounter < _nextPurgeTime) {
+		return;
+	}
+
+	_nextPurgeTime = OpenAnimationReplacer::gameTimeCounter + purgeInterval;
+
+	WriteLocker locker(_lock);
+
+	// drop refrs that no longer exist at that address
+	std::erase_if(_cache, [](const auto& a_entry) {
+		return RE::TESForm::LookupByID(a_entry.second.formID) != a_entry.first;
+	});
+}
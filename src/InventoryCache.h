@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Utils.h"
+
+// caches the results of inventory queries per actor and form, invalidated from the event handler when the inventory or equipment of the actor changes
+class InventoryCache final
+{
+public:
+	static InventoryCache& GetSingleton()
+	{
+		static InventoryCache singleton;
+		return singleton;
+	}
+
+	[[nodiscard]] Utils::InventoryItemInfo GetItemInfo(RE::TESObjectREFR* a_refr, RE::FormID a_formID);
+
+	void Invalidate(RE::TESObjectREFR* a_refr);
+	void Clear();
+
+	// drops the entries of refrs that no longer exist, throttled so it can be called every frame
+	void PurgeInvalidEntries();
+
+private:
+	InventoryCache() = default;
+	InventoryCache(const InventoryCache&) = delete;
+	InventoryCache(InventoryCache&&) = delete;
+	~InventoryCache() = default;
+
+	InventoryCache& operator=(const InventoryCache&) = delete;
+	InventoryCache& operator=(InventoryCache&&) = delete;
+
+	static constexpr float purgeInterval = 10.f;
+
+	// keyed by the refr pointer to stay off the handle manager, the form id catches a freed refr's address being reused
+	struct RefrEntry
+	{
+		RE::FormID formID = 0;
+		std::unordered_map<RE::FormID, Utils::InventoryItemInfo> items;
+	};
+
+	mutable SharedLock _lock;
+	std::unordered_map<const RE::TESObjectREFR*, RefrEntry> _cache;
+	uint64_t _generation = 0;  // bumped by every invalidation, so a query computed across one isn't stored
+	float _nextPurgeTime = 0.f;
+};
@@ -117,11 +117,13 @@ namespace Jobs
 	void AddTriggerJob::Run()
 	{
 		func->AddTrigger(trigger.event, trigger.payload);
+		functionSet->InvalidateTriggerIndex();
 	}
 
 	void RemoveTriggerJob::Run()
 	{
 		func->RemoveTrigger(trigger.event, trigger.payload);
+		functionSet->InvalidateTriggerIndex();
 	}
 
 }
@@ -0,0 +1,143 @@
+#include "LockStats.h"
+
+#ifdef USE_INSTRUMENTED_LOCKS
+
+namespace LockStats
+{
+	namespace
+	{
+		constexpr size_t siteCapacity = 1024;
+
+		// insert-only open addressing table shared by all threads
+		std::array<Site, siteCapacity> sites;
+
+		void UpdateMax(std::atomic<uint64_t>& a_max, uint64_t a_value)
+		{
+			uint64_t current = a_max.load(std::memory_order_relaxed);
+			while (a_value > current && !a_max.compare_exchange_weak(current, a_value, std::memory_order_relaxed)) {}
+		}
+	}
+
+	void Site::RecordAcquire(uint64_t a_waitNanoseconds)
+	{
+		acquireCount.fetch_add(1, std::memory_order_relaxed);
+		if (a_waitNanoseconds >= contendedWaitThreshold) {
+			contendedCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		totalWaitNanoseconds.fetch_add(a_waitNanoseconds, std::memory_order_relaxed);
+		UpdateMax(maxWaitNanoseconds, a_waitNanoseconds);
+	}
+
+	void Site::RecordHold(uint64_t a_holdNanoseconds)
+	{
+		totalHoldNanoseconds.fetch_add(a_holdNanoseconds, std::memory_order_relaxed);
+		UpdateMax(maxHoldNanoseconds, a_holdNanoseconds);
+	}
+
+	void Site::Reset()
+	{
+		acquireCount.store(0, std::memory_order_relaxed);
+		contendedCount.store(0, std::memory_order_relaxed);
+		totalWaitNanoseconds.store(0, std::memory_order_relaxed);
+		maxWaitNanoseconds.store(0, std::memory_order_relaxed);
+		totalHoldNanoseconds.store(0, std::memory_order_relaxed);
+		maxHoldNanoseconds.store(0, std::memory_order_relaxed);
+	}
+
+	Site* FindOrAddSite(const std::source_location& a_location, LockType a_type)
+	{
+		// the file name is a string literal so its address identifies the file, the line goes in the low bits
+		const uint64_t key = (reinterpret_cast<uint64_t>(a_location.file_name()) << 16) | (a_location.line() & 0xFFFF);
+
+		size_t index = std::hash<uint64_t>{}(key) % siteCapacity;
+		for (size_t i = 0; i < siteCapacity; ++i) {
+			auto& site = sites[index];
+			uint64_t siteKey = site.key.load(std::memory_order_acquire);
+			if (siteKey == 0 && site.key.compare_exchange_strong(siteKey, key, std::memory_order_acq_rel)) {
+				site.file = a_location.file_name();
+				site.function = a_location.function_name();
+				site.line = a_location.line();
+				site.type = a_type;
+				site.bPublished.store(true, std::memory_order_release);
+				return &site;
+			}
+			if (siteKey == key) {
+				return &site;
+			}
+			index = (index + 1) % siteCapacity;
+		}
+
+		return nullptr;
+	}
+
+	std::vector<SiteStats> GetStats()
+	{
+		std::vector<SiteStats> result;
+
+		for (const auto& site : sites) {
+			if (!site.bPublished.load(std::memory_order_acquire)) {
+				continue;
+			}
+
+			const uint64_t acquireCount = site.acquireCount.load(std::memory_order_relaxed);
+			if (acquireCount == 0) {
+				continue;
+			}
+
+			const auto fileName = std::filesystem::path(site.file).filename().string();
+			result.emplace_back(std::format("{}:{} ({})", fileName, site.line, site.function),
+				site.type,
+				acquireCount,
+				site.contendedCount.load(std::memory_order_relaxed),
+				site.totalWaitNanoseconds.load(std::memory_order_relaxed),
+				site.maxWaitNanoseconds.load(std::memory_order_relaxed),
+				site.totalHoldNanoseconds.load(std::memory_order_relaxed),
+				site.maxHoldNanoseconds.load(std::memory_order_relaxed));
+		}
+
+		std::ranges::sort(result, std::greater{}, &SiteStats::totalWaitNanoseconds);
+
+		return result;
+	}
+
+	std::string_view GetLockTypeName(LockType a_type)
+	{
+		switch (a_type) {
+		case LockType::kExclusive:
+			return "Exclusive"sv;
+		case LockType::kRead:
+			return "Read"sv;
+		case LockType::kWrite:
+			return "Write"sv;
+		}
+
+		return ""sv;
+	}
+
+	void Reset()
+	{
+		for (auto& site : sites) {
+			site.Reset();
+		}
+	}
+
+	void LogStats()
+	{
+		const auto stats = GetStats();
+
+		logger::info("Lock statistics ({} sites):", stats.size());
+		for (const auto& site : stats) {
+			logger::info("  [{}] {} - acquired {} times, contended {} times, wait total {} us / max {} us, hold average {} ns / max {} us",
+				GetLockTypeName(site.type),
+				site.name,
+				site.acquireCount,
+				site.contendedCount,
+				site.totalWaitNanoseconds / 1000,
+				site.maxWaitNanoseconds / 1000,
+				site.totalHoldNanoseconds / site.acquireCount,
+				site.maxHoldNanoseconds / 1000);
+		}
+	}
+}
+
+#endif
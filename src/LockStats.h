@@ -0,0 +1,149 @@
+#pragma once
+
+#ifdef USE_INSTRUMENTED_LOCKS
+
+#	include <source_location>
+
+// contention instrumentation for the lock guards, only compiled in with USE_INSTRUMENTED_LOCKS. Every acquisition site (the file and line of the guard) records how often it was taken, how long it waited and how long the lock was held
+namespace LockStats
+{
+	enum class LockType : uint8_t
+	{
+		kExclusive,
+		kRead,
+		kWrite
+	};
+
+	// waits shorter than this are counted as uncontended, reading the clock alone takes a fraction of it
+	inline constexpr uint64_t contendedWaitThreshold = 1000;
+
+	class Site
+	{
+	public:
+		void RecordAcquire(uint64_t a_waitNanoseconds);
+		void RecordHold(uint64_t a_holdNanoseconds);
+		void Reset();
+
+		std::atomic<uint64_t> key = 0;
+		std::atomic_bool bPublished = false;
+		const char* file = nullptr;
+		const char* function = nullptr;
+		uint32_t line = 0;
+		LockType type = LockType::kExclusive;
+
+		std::atomic<uint64_t> acquireCount = 0;
+		std::atomic<uint64_t> contendedCount = 0;
+		std::atomic<uint64_t> totalWaitNanoseconds = 0;
+		std::atomic<uint64_t> maxWaitNanoseconds = 0;
+		std::atomic<uint64_t> totalHoldNanoseconds = 0;
+		std::atomic<uint64_t> maxHoldNanoseconds = 0;
+	};
+
+	struct SiteStats
+	{
+		std::string name;
+		LockType type;
+		uint64_t acquireCount;
+		uint64_t contendedCount;
+		uint64_t totalWaitNanoseconds;
+		uint64_t maxWaitNanoseconds;
+		uint64_t totalHoldNanoseconds;
+		uint64_t maxHoldNanoseconds;
+	};
+
+	[[nodiscard]] inline uint64_t Now() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+	// returns nullptr once the site table is full
+	[[nodiscard]] Site* FindOrAddSite(const std::source_location& a_location, LockType a_type);
+
+	// sorted by total wait time
+	[[nodiscard]] std::vector<SiteStats> GetStats();
+	[[nodiscard]] std::string_view GetLockTypeName(LockType a_type);
+	void Reset();
+	void LogStats();
+
+	template <class Lock, LockType Type>
+	class InstrumentedGuard
+	{
+	public:
+		explicit InstrumentedGuard(Lock& a_lock, std::source_location a_location = std::source_location::current()) :
+			_lock(a_lock), _site(FindOrAddSite(a_location, Type))
+		{
+			const uint64_t startTime = Now();
+			Acquire();
+			_acquireTime = Now();
+
+			if (_site) {
+				_site->RecordAcquire(_acquireTime - startTime);
+			}
+		}
+
+		~InstrumentedGuard()
+		{
+			if (_site) {
+				_site->RecordHold(Now() - _acquireTime);
+			}
+
+			Release();
+		}
+
+		InstrumentedGuard(const InstrumentedGuard&) = delete;
+		InstrumentedGuard(InstrumentedGuard&&) = delete;
+		InstrumentedGuard& operator=(const InstrumentedGuard&) = delete;
+		InstrumentedGuard& operator=(InstrumentedGuard&&) = delete;
+
+	private:
+		// works with both the game's locks and the standard ones
+		void Acquire()
+		{
+			if constexpr (Type == LockType::kExclusive) {
+				if constexpr (requires { _lock.Lock(); }) {
+					_lock.Lock();
+				} else {
+					_lock.lock();
+				}
+			} else if constexpr (Type == LockType::kRead) {
+				if constexpr (requires { _lock.LockForRead(); }) {
+					_lock.LockForRead();
+				} else {
+					_lock.lock_shared();
+				}
+			} else {
+				if constexpr (requires { _lock.LockForWrite(); }) {
+					_lock.LockForWrite();
+				} else {
+					_lock.lock();
+				}
+			}
+		}
+
+		void Release()
+		{
+			if constexpr (Type == LockType::kExclusive) {
+				if constexpr (requires { _lock.Unlock(); }) {
+					_lock.Unlock();
+				} else {
+					_lock.unlock();
+				}
+			} else if constexpr (Type == LockType::kRead) {
+				if constexpr (requires { _lock.UnlockForRead(); }) {
+					_lock.UnlockForRead();
+				} else {
+					_lock.unlock_shared();
+				}
+			} else {
+				if constexpr (requires { _lock.UnlockForWrite(); }) {
+					_lock.UnlockForWrite();
+				} else {
+					_lock.unlock();
+				}
+			}
+		}
+
+		Lock& _lock;
+		Site* _site;
+		uint64_t _acquireTime = 0;
+	};
+}
+
+#endif
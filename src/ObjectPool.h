@@ -0,0 +1,178 @@
+#pragma once
+
+// thread-safe pool of same-sized blocks carved out of slabs. Freed blocks go back on a free list, slabs are only released with the pool.
+// the tag separates pools so each one reports its own occupancy
+template <class Tag>
+class BlockPool
+{
+public:
+	static BlockPool& GetSingleton()
+	{
+		// never destroyed, pooled objects held by other singletons can be freed after static destruction has started
+		static BlockPool* singleton = new BlockPool();
+		return *singleton;
+	}
+
+	// the block size is set by the first allocation, any other size falls back to the heap
+	[[nodiscard]] void* Allocate(size_t a_size)
+	{
+		{
+			Locker locker(_lock);
+
+			if (_blockSize == 0) {
+				_blockSize = (std::max(a_size, sizeof(FreeBlock)) + blockAlignment - 1) & ~(blockAlignment - 1);
+			}
+
+			if (a_size <= _blockSize) {
+				if (!_freeList) {
+					AddSlab();
+				}
+
+				const auto block = _freeList;
+				_freeList = block->next;
+
+				const size_t currentCount = ++_currentCount;
+				_peakCount = std::max(_peakCount.load(std::memory_order_relaxed), currentCount);
+
+				return block;
+			}
+		}
+
+		return ::operator new(a_size);
+	}
+
+	void Deallocate(void* a_block, size_t a_size)
+	{
+		if (!a_block) {
+			return;
+		}
+
+		{
+			Locker locker(_lock);
+
+			if (a_size <= _blockSize) {
+				const auto block = static_cast<FreeBlock*>(a_block);
+				block->next = _freeList;
+				_freeList = block;
+				--_currentCount;
+				return;
+			}
+		}
+
+		::operator delete(a_block);
+	}
+
+	[[nodiscard]] size_t GetCurrentCount() const { return _currentCount.load(std::memory_order_relaxed); }
+	[[nodiscard]] size_t GetPeakCount() const { return _peakCount.load(std::memory_order_relaxed); }
+	[[nodiscard]] size_t GetCapacity() const { return _capacity.load(std::memory_order_relaxed); }
+
+private:
+	BlockPool() = default;
+	BlockPool(const BlockPool&) = delete;
+	BlockPool(BlockPool&&) = delete;
+	~BlockPool() = default;
+
+	BlockPool& operator=(const BlockPool&) = delete;
+	BlockPool& operator=(BlockPool&&) = delete;
+
+	static constexpr size_t blocksPerSlab = 64;
+	static constexpr size_t blockAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	// called with the lock held
+	void AddSlab()
+	{
+		auto& slab = _slabs.emplace_back(std::make_unique<std::byte[]>(_blockSize * blocksPerSlab));
+		for (size_t i = blocksPerSlab; i > 0; --i) {
+			const auto block = reinterpret_cast<FreeBlock*>(slab.get() + (i - 1) * _blockSize);
+			block->next = _freeList;
+			_freeList = block;
+		}
+		_capacity += blocksPerSlab;
+	}
+
+	ExclusiveLock _lock;
+	FreeBlock* _freeList = nullptr;
+	std::vector<std::unique_ptr<std::byte[]>> _slabs;
+	size_t _blockSize = 0;
+
+	std::atomic<size_t> _currentCount = 0;
+	std::atomic<size_t> _peakCount = 0;
+	std::atomic<size_t> _capacity = 0;
+};
+
+// allocator for std::allocate_shared, so the object and its control block share one pooled block
+template <class T, class Tag = T>
+struct PoolAllocator
+{
+	using value_type = T;
+
+	PoolAllocator() = default;
+
+	template <class U>
+	PoolAllocator(const PoolAllocator<U, Tag>&) noexcept
+	{}
+
+	template <class U>
+	struct rebind
+	{
+		using other = PoolAllocator<U, Tag>;
+	};
+
+	static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+	[[nodiscard]] T* allocate(size_t a_count)
+	{
+		if (a_count == 1) {
+			return static_cast<T*>(BlockPool<Tag>::GetSingleton().Allocate(sizeof(T)));
+		}
+		return std::allocator<T>().allocate(a_count);
+	}
+
+	void deallocate(T* a_ptr, size_t a_count)
+	{
+		if (a_count == 1) {
+			BlockPool<Tag>::GetSingleton().Deallocate(a_ptr, sizeof(T));
+		} else {
+			std::allocator<T>().deallocate(a_ptr, a_count);
+		}
+	}
+
+	template <class U>
+	bool operator==(const PoolAllocator<U, Tag>&) const noexcept
+	{
+		return true;
+	}
+};
+
+template <class T>
+struct PoolDeleter
+{
+	void operator()(T* a_ptr) const
+	{
+		a_ptr->~T();
+		BlockPool<T>::GetSingleton().Deallocate(a_ptr, sizeof(T));
+	}
+};
+
+template <class T>
+using PoolPtr = std::unique_ptr<T, PoolDeleter<T>>;
+
+template <class T, class... Args>
+[[nodiscard]] PoolPtr<T> MakePooled(Args&&... a_args)
+{
+	static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+	auto& pool = BlockPool<T>::GetSingleton();
+	void* block = pool.Allocate(sizeof(T));
+	try {
+		return PoolPtr<T>(new (block) T(std::forward<Args>(a_args)...));
+	} catch (...) {
+		pool.Deallocate(block, sizeof(T));
+		throw;
+	}
+}
@@ -2,6 +2,7 @@
 
 #include "ActiveClip.h"
 #include "DetectedProblems.h"
+#include "EventHandler.h"
 #include "MergeMapperPluginAPI.h"
 #include "Offsets.h"
 #include "Parsing.h"
@@ -41,6 +42,8 @@ void OpenAnimationReplacer::OnDataLoaded()
 
 	CreateReplacerMods();
 
+	EventHandler::Register();
+
 	if (Settings::bLoadDefaultBehaviorsInMainMenu && !Settings::bDisablePreloading) {
 		InitDefaultProjects();
 	}
@@ -168,6 +171,7 @@ void OpenAnimationReplacer::InitializeReplacementAnimations(RE::hkbCharacterStri
 		projectData->ForEach([](auto a_animationReplacements) {
 			a_animationReplacements->TestInterruptible();
 			a_animationReplacements->TestReplaceOnEcho();
+			a_animationReplacements->TestConditionDependencies();
 			a_animationReplacements->SortByPriority();
 		});
 	}
@@ -186,15 +190,22 @@ AnimationReplacements* OpenAnimationReplacer::GetReplacements(RE::hkbCharacter*
 	return nullptr;
 }
 
-ActiveClip* OpenAnimationReplacer::GetActiveClip(RE::hkbClipGenerator* a_clipGenerator) const
+bool OpenAnimationReplacer::HasReplacements(RE::hkbCharacter* a_character, uint16_t a_originalIndex) const
 {
-	ReadLocker locker(_activeClipsLock);
-
-	if (const auto search = _activeClips.find(a_clipGenerator); search != _activeClips.end()) {
-		return search->second.get();
+	if (a_originalIndex != static_cast<uint16_t>(-1)) {
+		if (const auto stringData = Utils::GetStringDataFromHkbCharacter(a_character)) {
+			if (const auto replacerProjectData = GetReplacerProjectData(stringData)) {
+				return replacerProjectData->HasAnimationReplacements(a_originalIndex);
+			}
+		}
 	}
 
-	return nullptr;
+	return false;
+}
+
+ActiveClip* OpenAnimationReplacer::GetActiveClip(RE::hkbClipGenerator* a_clipGenerator) const
+{
+	return _activeClipLookup.Find(a_clipGenerator);
 }
 
 std::shared_ptr<ActiveClip> OpenAnimationReplacer::GetActiveClipSharedPtr(RE::hkbClipGenerator* a_clipGenerator) const
@@ -212,11 +223,8 @@ ActiveClip* OpenAnimationReplacer::GetActiveClipForRefr(RE::TESObjectREFR* a_ref
 {
 	ReadLocker locker(_activeClipsLock);
 
-	if (const auto search = std::ranges::find_if(_activeClips, [&](const auto& pair) {
-			return pair.second->GetRefr() == a_refr;
-		});
-		search != _activeClips.end()) {
-		return search->second.get();
+	if (const auto search = _refrToActiveClipsMap.find(a_refr); search != _refrToActiveClipsMap.end()) {
+		return search->second.front();
 	}
 
 	return nullptr;
@@ -238,27 +246,30 @@ ActiveClip* OpenAnimationReplacer::GetActiveClipWithPredicate(std::function<bool
 
 std::vector<ActiveClip*> OpenAnimationReplacer::GetActiveClipsForRefr(RE::TESObjectREFR* a_refr) const
 {
-	std::vector<ActiveClip*> results;
-
 	ReadLocker locker(_activeClipsLock);
 
-	if (const auto search = std::ranges::find_if(_activeClips, [&](const auto& pair) {
-			return pair.second->GetRefr() == a_refr;
-		});
-		search != _activeClips.end()) {
-		results.emplace_back(search->second.get());
+	if (const auto search = _refrToActiveClipsMap.find(a_refr); search != _refrToActiveClipsMap.end()) {
+		return search->second;
 	}
 
-	return results;
+	return {};
 }
 
 ActiveClip* OpenAnimationReplacer::AddOrGetActiveClip(RE::hkbClipGenerator* a_clipGenerator, const RE::hkbContext& a_context, bool& a_bOutAdded)
 {
+	// the clip generator is usually already active when called from the synchronized animation paths
+	if (const auto activeClip = _activeClipLookup.Find(a_clipGenerator)) {
+		a_bOutAdded = false;
+		return activeClip;
+	}
+
 	WriteLocker locker(_activeClipsLock);
 
 	auto [newClipIt, result] = _activeClips.try_emplace(a_clipGenerator, nullptr);
 	if (result) {
-		newClipIt->second = std::make_shared<ActiveClip>(a_clipGenerator, a_context.character, a_context.behavior);
+		newClipIt->second = std::allocate_shared<ActiveClip>(PoolAllocator<ActiveClip>(), a_clipGenerator, a_context.character, a_context.behavior);
+		_activeClipLookup.Insert(a_clipGenerator, newClipIt->second.get());
+		_refrToActiveClipsMap[newClipIt->second->GetRefr()].emplace_back(newClipIt->second.get());
 	}
 
 	a_bOutAdded = result;
@@ -267,6 +278,11 @@ ActiveClip* OpenAnimationReplacer::AddOrGetActiveClip(RE::hkbClipGenerator* a_cl
 
 void OpenAnimationReplacer::RemoveActiveClip(RE::hkbClipGenerator* a_clipGenerator)
 {
+	// most deactivated clips were never tracked, skip the lock for them
+	if (!_activeClipLookup.Find(a_clipGenerator)) {
+		return;
+	}
+
 	std::shared_ptr<ActiveClip> activeClip = nullptr;
 
 	{
@@ -274,11 +290,24 @@ void OpenAnimationReplacer::RemoveActiveClip(RE::hkbClipGenerator* a_clipGenerat
 
 		if (const auto search = _activeClips.find(a_clipGenerator); search != _activeClips.end()) {
 			if (!search->second->IsTransitioning()) {
-				activeClip = search->second;  // keep it alive until we release the lock
+				activeClip = search->second;
+				_activeClipLookup.Erase(a_clipGenerator);
+				if (const auto refrSearch = _refrToActiveClipsMap.find(activeClip->GetRefr()); refrSearch != _refrToActiveClipsMap.end()) {
+					std::erase(refrSearch->second, activeClip.get());
+					if (refrSearch->second.empty()) {
+						_refrToActiveClipsMap.erase(refrSearch);
+					}
+				}
 				_activeClips.erase(search);
 			}
 		}
 	}
+
+	if (activeClip) {
+		// lookups don't take the lock, so another thread might still be using the clip. Restore the clip generator now, but free the clip after the grace period
+		activeClip->Detach();
+		SnapshotReclaimer::GetSingleton().Retire(std::move(activeClip));
+	}
 }
 
 void OpenAnimationReplacer::ForEachActiveClip(const std::function<void(ActiveClip*)>& a_func) const
@@ -290,6 +319,143 @@ void OpenAnimationReplacer::ForEachActiveClip(const std::function<void(ActiveCli
 	}
 }
 
+void OpenAnimationReplacer::OnConditionDependencyChanged(RE::TESObjectREFR* a_refr, Utils::ConditionDependency a_dependency) const
+{
+	if (!Settings::bTrackConditionDependencies) {
+		return;
+	}
+
+	ReadLocker locker(_activeClipsLock);
+
+	if (a_refr) {
+		if (const auto search = _refrToActiveClipsMap.find(a_refr); search != _refrToActiveClipsMap.end()) {
+			for (const auto activeClip : search->second) {
+				activeClip->OnConditionDependencyChanged(a_dependency);
+			}
+		}
+		return;
+	}
+
+	for (auto& activeClip : _activeClips | std::views::values) {
+		activeClip->OnConditionDependencyChanged(a_dependency);
+	}
+}
+
+void OpenAnimationReplacer::UpdateConditionDependencies() const
+{
+	ForEachReplacerProjectData([](auto, auto a_projectData) {
+		a_projectData->ForEach([](auto a_animationReplacements) {
+			a_animationReplacements->TestConditionDependencies();
+		});
+	});
+
+	// conditions might have been edited, so re-evaluate everything once
+	OnConditionDependencyChanged(nullptr, Utils::ConditionDependency::kAll);
+}
+
+void OpenAnimationReplacer::CheckGameTimeDependency()
+{
+	if (!Settings::bTrackConditionDependencies) {
+		return;
+	}
+
+	if (const auto calendar = RE::Calendar::GetSingleton()) {
+		const auto gameMinute = static_cast<uint32_t>(calendar->GetCurrentGameTime() * 24.f * 60.f);
+		if (gameMinute != _lastGameMinute) {
+			_lastGameMinute = gameMinute;
+			OnConditionDependencyChanged(nullptr, Utils::ConditionDependency::kGameTime);
+		}
+	}
+}
+
+bool OpenAnimationReplacer::IsNoMatchCached(RE::TESObjectREFR* a_refr, const AnimationReplacements* a_replacements) const
+{
+	if (!a_refr) {
+		return false;
+	}
+
+	ReadLocker locker(_noMatchCacheLock);
+
+	if (const auto it = _noMatchCache.find({ a_refr, a_replacements }); it != _noMatchCache.end() && it->second.formID == a_refr->GetFormID() && it->second.expiryTime > gameTimeCounter) {
+		++noMatchCacheHitCount;
+		return true;
+	}
+
+	++noMatchCacheMissCount;
+	return false;
+}
+
+void OpenAnimationReplacer::CacheNoMatch(RE::TESObjectREFR* a_refr, const AnimationReplacements* a_replacements)
+{
+	if (!a_refr) {
+		return;
+	}
+
+	WriteLocker locker(_noMatchCacheLock);
+
+	const auto [it, bInserted] = _noMatchCache.insert_or_assign({ a_refr, a_replacements }, NoMatchCacheEntry{ a_refr->GetFormID(), gameTimeCounter + Settings::fNoMatchCacheLifetime });
+	if (bInserted) {
+		_noMatchCacheRefrIndex[a_refr].push_back(a_replacements);
+	}
+}
+
+void OpenAnimationReplacer::ClearNoMatchCache(RE::TESObjectREFR* a_refr /*= nullptr*/)
+{
+	if (!a_refr) {
+		WriteLocker locker(_noMatchCacheLock);
+		_noMatchCache.clear();
+		_noMatchCacheRefrIndex.clear();
+		return;
+	}
+
+	// called for every loaded reference, most of which never had an entry
+	if (Settings::fNoMatchCacheLifetime <= 0.f) {
+		return;
+	}
+
+	{
+		ReadLocker locker(_noMatchCacheLock);
+		if (!_noMatchCacheRefrIndex.contains(a_refr)) {
+			return;
+		}
+	}
+
+	WriteLocker locker(_noMatchCacheLock);
+
+	if (const auto search = _noMatchCacheRefrIndex.find(a_refr); search != _noMatchCacheRefrIndex.end()) {
+		for (const auto replacements : search->second) {
+			_noMatchCache.erase({ a_refr, replacements });
+		}
+		_noMatchCacheRefrIndex.erase(search);
+	}
+}
+
+void OpenAnimationReplacer::PurgeExpiredNoMatchCache()
+{
+	if (gameTimeCounter < _nextNoMatchCachePurgeTime) {
+		return;
+	}
+
+	_nextNoMatchCachePurgeTime = gameTimeCounter + std::max(Settings::fNoMatchCacheLifetime, 1.f);
+
+	WriteLocker locker(_noMatchCacheLock);
+
+	std::erase_if(_noMatchCache, [&](const auto& a_entry) {
+		if (a_entry.second.expiryTime > gameTimeCounter) {
+			return false;
+		}
+
+		const auto& [refr, replacements] = a_entry.first;
+		if (const auto search = _noMatchCacheRefrIndex.find(refr); search != _noMatchCacheRefrIndex.end()) {
+			std::erase(search->second, replacements);
+			if (search->second.empty()) {
+				_noMatchCacheRefrIndex.erase(search);
+			}
+		}
+		return true;
+	});
+}
+
 void OpenAnimationReplacer::OnActiveClipLoopOrEcho(ActiveClip* a_activeClip, bool a_bIsEcho)
 {
 	const auto refr = a_activeClip->GetRefr();
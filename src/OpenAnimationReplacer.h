@@ -39,6 +39,7 @@ public:
 
 	void InitializeReplacementAnimations(RE::hkbCharacterStringData* a_stringData) const;
 	[[nodiscard]] AnimationReplacements* GetReplacements(RE::hkbCharacter* a_character, uint16_t a_originalIndex) const;
+	[[nodiscard]] bool HasReplacements(RE::hkbCharacter* a_character, uint16_t a_originalIndex) const;
 
 	[[nodiscard]] ActiveClip* GetActiveClip(RE::hkbClipGenerator* a_clipGenerator) const;
 	[[nodiscard]] std::shared_ptr<ActiveClip> GetActiveClipSharedPtr(RE::hkbClipGenerator* a_clipGenerator) const;
@@ -51,6 +52,15 @@ public:
 
 	void OnActiveClipLoopOrEcho(ActiveClip* a_activeClip, bool a_bIsEcho);
 
+	void OnConditionDependencyChanged(RE::TESObjectREFR* a_refr, Utils::ConditionDependency a_dependency) const;
+	void UpdateConditionDependencies() const;
+	void CheckGameTimeDependency();
+
+	[[nodiscard]] bool IsNoMatchCached(RE::TESObjectREFR* a_refr, const AnimationReplacements* a_replacements) const;
+	void CacheNoMatch(RE::TESObjectREFR* a_refr, const AnimationReplacements* a_replacements);
+	void ClearNoMatchCache(RE::TESObjectREFR* a_refr = nullptr);
+	void PurgeExpiredNoMatchCache();
+
 	[[nodiscard]] ActiveSynchronizedAnimation* GetActiveSynchronizedAnimationForRefr(RE::TESObjectREFR* a_refr) const;
 	ActiveSynchronizedAnimation* AddOrGetActiveSynchronizedAnimation(RE::BGSSynchronizedAnimationInstance* a_synchronizedAnimationInstance);
 	[[nodiscard]] ActiveSynchronizedAnimation* GetActiveSynchronizedAnimation(RE::BGSSynchronizedAnimationInstance* a_synchronizedAnimationInstance);
@@ -158,6 +168,11 @@ public:
 	static inline std::atomic_bool bIsPreLoading = false;
 	static inline float gameTimeCounter = 0.f;
 
+	static inline std::atomic_uint64_t interruptibleEvaluationCount = 0;
+	static inline std::atomic_uint64_t skippedInterruptibleEvaluationCount = 0;
+	static inline std::atomic_uint64_t noMatchCacheHitCount = 0;
+	static inline std::atomic_uint64_t noMatchCacheMissCount = 0;
+
 protected:
 	ExclusiveLock _parseLock;
 	ExclusiveLock _animationCreationLock;
@@ -177,6 +192,24 @@ protected:
 
 	mutable SharedLock _activeClipsLock;
 	std::unordered_map<RE::hkbClipGenerator*, std::shared_ptr<ActiveClip>> _activeClips;
+	PointerLookupTable<RE::hkbClipGenerator, ActiveClip> _activeClipLookup;  // mirrors _activeClips for the hooks, read without taking the lock
+	std::unordered_map<RE::TESObjectREFR*, std::vector<ActiveClip*>> _refrToActiveClipsMap;  // guarded by _activeClipsLock, a clip's refr never changes
+
+	uint32_t _lastGameMinute = 0;
+
+	// refrs for which none of the replacements of an original animation matched, with the time the entry expires at.
+	// keyed by the refr pointer to stay off the handle manager, the form id catches a freed refr's address being reused
+	struct NoMatchCacheEntry
+	{
+		RE::FormID formID;
+		float expiryTime;
+	};
+
+	using NoMatchCacheKey = std::pair<const RE::TESObjectREFR*, const AnimationReplacements*>;
+	mutable SharedLock _noMatchCacheLock;
+	std::unordered_map<NoMatchCacheKey, NoMatchCacheEntry, KeyHash<NoMatchCacheKey>> _noMatchCache;
+	std::unordered_map<const RE::TESObjectREFR*, std::vector<const AnimationReplacements*>> _noMatchCacheRefrIndex;  // the cached replacements of each refr, so clearing one refr doesn't scan the whole cache
+	float _nextNoMatchCachePurgeTime = 0.f;
 
 	mutable SharedLock _activeSynchronizedAnimationsLock;
 	std::unordered_map<RE::BGSSynchronizedAnimationInstance*, std::unique_ptr<ActiveSynchronizedAnimation>> _activeSynchronizedAnimations;
@@ -5,6 +5,7 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 
 #define USE_BS_LOCKS
+// #define USE_INSTRUMENTED_LOCKS  // record per-site lock contention, see LockStats.h
 
 #pragma warning(push)
 #include <RE/Skyrim.h>
@@ -191,16 +192,24 @@ struct CaseInsensitivePathEqual
 
 #ifdef USE_BS_LOCKS
 using ExclusiveLock = RE::BSSpinLock;
-using Locker = RE::BSSpinLockGuard;
-
 using SharedLock = RE::BSReadWriteLock;
+#else
+using ExclusiveLock = std::mutex;
+using SharedLock = std::shared_mutex;
+#endif
+
+#ifdef USE_INSTRUMENTED_LOCKS
+#	include "LockStats.h"
+
+using Locker = LockStats::InstrumentedGuard<ExclusiveLock, LockStats::LockType::kExclusive>;
+using ReadLocker = LockStats::InstrumentedGuard<SharedLock, LockStats::LockType::kRead>;
+using WriteLocker = LockStats::InstrumentedGuard<SharedLock, LockStats::LockType::kWrite>;
+#elif defined(USE_BS_LOCKS)
+using Locker = RE::BSSpinLockGuard;
 using ReadLocker = RE::BSReadLockGuard;
 using WriteLocker = RE::BSWriteLockGuard;
 #else
-using ExclusiveLock = std::mutex;
 using Locker = std::lock_guard<ExclusiveLock>;
-
-using SharedLock = std::shared_mutex;
 using ReadLocker = std::shared_lock<SharedLock>;
 using WriteLocker = std::unique_lock<SharedLock>;
 #endif
@@ -0,0 +1,107 @@
+#include "PoseBlending.h"
+
+#include <xmmintrin.h>
+
+namespace PoseBlending
+{
+	namespace
+	{
+		static_assert(sizeof(RE::hkQsTransform) == 3 * sizeof(__m128));
+
+		struct Transform
+		{
+			__m128 translation;
+			__m128 rotation;
+			__m128 scale;
+		};
+
+		Transform Load(const RE::hkQsTransform& a_transform)
+		{
+			const auto data = reinterpret_cast<const float*>(&a_transform);
+			return { _mm_loadu_ps(data), _mm_loadu_ps(data + 4), _mm_loadu_ps(data + 8) };
+		}
+
+		void Store(const Transform& a_transform, RE::hkQsTransform& a_out)
+		{
+			const auto data = reinterpret_cast<float*>(&a_out);
+			_mm_storeu_ps(data, a_transform.translation);
+			_mm_storeu_ps(data + 4, a_transform.rotation);
+			_mm_storeu_ps(data + 8, a_transform.scale);
+		}
+
+		// sum of the products in every lane
+		__m128 Dot4(__m128 a_lhs, __m128 a_rhs)
+		{
+			__m128 product = _mm_mul_ps(a_lhs, a_rhs);
+			product = _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1)));
+			return _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(1, 0, 3, 2)));
+		}
+
+		__m128 Lerp(__m128 a_from, __m128 a_to, __m128 a_amount)
+		{
+			return _mm_add_ps(a_from, _mm_mul_ps(_mm_sub_ps(a_to, a_from), a_amount));
+		}
+
+		// from * (1 - amount) + to * amount
+		Transform Blend(const Transform& a_from, const Transform& a_to, __m128 a_amount)
+		{
+			// flip the target rotation into the same hemisphere so the shortest path is taken
+			const __m128 sign = _mm_and_ps(_mm_cmplt_ps(Dot4(a_from.rotation, a_to.rotation), _mm_setzero_ps()), _mm_set1_ps(-0.f));
+			const __m128 toRotation = _mm_xor_ps(a_to.rotation, sign);
+
+			const __m128 rotation = Lerp(a_from.rotation, toRotation, a_amount);
+			const __m128 length = _mm_sqrt_ps(Dot4(rotation, rotation));
+
+			return {
+				Lerp(a_from.translation, a_to.translation, a_amount),
+				_mm_div_ps(rotation, length),
+				Lerp(a_from.scale, a_to.scale, a_amount)
+			};
+		}
+	}
+
+	void BlendLayers(std::span<const Layer> a_layers, RE::hkQsTransform* a_out, uint32_t a_numOutTracks)
+	{
+		if (a_layers.empty()) {
+			return;
+		}
+
+		const uint32_t numTracks = std::min(a_layers.front().numTracks, a_numOutTracks);
+
+		// more than enough for the blending clips of a clip plus its output pose
+		std::array<__m128, 16> amounts;
+		const size_t numLayers = std::min(a_layers.size(), amounts.size());
+		for (size_t i = 0; i < numLayers; ++i) {
+			amounts[i] = _mm_set1_ps(a_layers[i].amount);
+		}
+
+		// each blend depends on the previous layer, so a block of tracks goes through every layer at once to keep several independent blends in flight.
+		// The block stays in registers or L1, so it's still a single pass over each pose
+		constexpr uint32_t blockSize = 8;
+		std::array<Transform, blockSize> accumulated;
+
+		for (uint32_t blockStart = 0; blockStart < numTracks; blockStart += blockSize) {
+			const uint32_t blockTracks = std::min(blockSize, numTracks - blockStart);
+
+			for (uint32_t i = 0; i < blockTracks; ++i) {
+				accumulated[i] = Load(a_layers[0].tracks[blockStart + i]);
+			}
+
+			for (size_t i = 1; i < numLayers; ++i) {
+				const auto& layer = a_layers[i];
+				if (blockStart >= layer.numTracks) {
+					continue;
+				}
+
+				const uint32_t layerTracks = std::min(blockTracks, layer.numTracks - blockStart);
+				for (uint32_t j = 0; j < layerTracks; ++j) {
+					accumulated[j] = Blend(Load(layer.tracks[blockStart + j]), accumulated[j], amounts[i]);
+				}
+			}
+
+			for (uint32_t i = 0; i < blockTracks; ++i) {
+				Store(accumulated[i], a_out[blockStart + i]);
+			}
+		}
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+namespace PoseBlending
+{
+	struct Layer
+	{
+		const RE::hkQsTransform* tracks = nullptr;
+		uint32_t numTracks = 0;
+		float amount = 0.f;  // weight of the pose accumulated from the previous layers, ignored for the first layer
+	};
+
+	// blends all layers in a single pass over the tracks. Each layer is applied like hkbBlendPoses(numTracks, layer, accumulated, amount, accumulated) would,
+	// lerping translation and scale and nlerping rotation in the same hemisphere. Only tracks present in the first layer are written, layers may alias a_out
+	void BlendLayers(std::span<const Layer> a_layers, RE::hkQsTransform* a_out, uint32_t a_numOutTracks);
+}
@@ -1,6 +1,7 @@
 #include "ReplacementAnimation.h"
 
 #include "AnimationFileHashCache.h"
+#include "ConditionProfiler.h"
 #include "OpenAnimationReplacer.h"
 #include "Parsing.h"
 #include "ReplacerMods.h"
@@ -309,8 +310,8 @@ RE::BSVisit::BSVisitControl ReplacementAnimation::ForEachVariant(const std::func
 
 bool ReplacementAnimation::EvaluateConditions(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const
 {
-	auto& animationLog = AnimationLog::GetSingleton();
-	ReplacementTrace* trace = animationLog.ShouldLogAnimationsForRefr(a_refr) ? OpenAnimationReplacer::GetSingleton().GetTrace(a_refr, a_clipGenerator) : nullptr;
+	ReplacementTrace* trace = EvaluationContext::ResolveTrace(a_refr, a_clipGenerator);
+	EvaluationContext context(a_refr, a_clipGenerator, trace);
 
 	if (trace) {
 		trace->TraceAnimation(this);
@@ -330,7 +331,14 @@ bool ReplacementAnimation::EvaluateConditions(RE::TESObjectREFR* a_refr, RE::hkb
 		return true;
 	}
 
-	bool bResult = _conditionSet->EvaluateAll(a_refr, a_clipGenerator, _parentSubMod);
+	bool bResult;
+	if (ConditionProfiler::IsEnabled()) {
+		const uint64_t startTime = ConditionProfiler::Now();
+		bResult = _conditionSet->EvaluateAll(a_refr, a_clipGenerator, _parentSubMod);
+		ConditionProfiler::GetSingleton().RecordSubMod(_parentSubMod, ConditionProfiler::Now() - startTime, bResult);
+	} else {
+		bResult = _conditionSet->EvaluateAll(a_refr, a_clipGenerator, _parentSubMod);
+	}
 	if (trace) {
 		trace->SetTraceAnimationResult(bResult ? ReplacementTrace::Step::StepResult::kSuccess : ReplacementTrace::Step::StepResult::kFail);
 	}
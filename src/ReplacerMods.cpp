@@ -3,9 +3,11 @@
 #include <ranges>
 
 #include "DetectedProblems.h"
+#include "FrameStats.h"
 #include "Offsets.h"
 #include "OpenAnimationReplacer.h"
 #include "Settings.h"
+#include "UI/UIManager.h"
 
 #include <unordered_set>
 
@@ -206,9 +208,13 @@ void SubMod::UpdateAnimations() const
 		a_replacerProject->ForEach([](auto a_animReplacements) {
 			a_animReplacements->TestInterruptible();
 			a_animReplacements->TestReplaceOnEcho();
+			a_animReplacements->TestConditionDependencies();
 			a_animReplacements->SortByPriority();
 		});
 	});
+
+	// mods might have been toggled or reordered
+	OpenAnimationReplacer::GetSingleton().ClearNoMatchCache();
 }
 
 RE::BSVisit::BSVisitControl TryRestorePreset(std::unique_ptr<Conditions::ICondition>& a_condition)
@@ -1290,22 +1296,35 @@ bool ReplacerMod::HasInvalidFunctions() const
 
 ReplacementAnimation* AnimationReplacements::EvaluateConditionsAndGetReplacementAnimation(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const
 {
-	ReadLocker locker(_lock);
+	FrameStats::GetSingleton().Increment(FrameStats::Counter::kEvaluations);
 
-	auto& animationLog = AnimationLog::GetSingleton();
-	ReplacementTrace* trace = animationLog.ShouldLogAnimationsForRefr(a_refr) ? OpenAnimationReplacer::GetSingleton().GetTrace(a_refr, a_clipGenerator) : nullptr;
+	const auto replacements = _snapshot.load(std::memory_order_acquire);
+
+	ReplacementTrace* trace = EvaluationContext::ResolveTrace(a_refr, a_clipGenerator);
+
+	if (replacements && !replacements->empty()) {
+		// skip the evaluation if nothing matched for this refr recently. Not used while tracing or editing so the results are always up to date there
+		const bool bUseNoMatchCache = Settings::fNoMatchCacheLifetime > 0.f && !trace && !UI::UIManager::GetSingleton().bShowMain;
+		if (bUseNoMatchCache && OpenAnimationReplacer::GetSingleton().IsNoMatchCached(a_refr, this)) {
+			return nullptr;
+		}
 
-	if (!_replacements.empty()) {
 		if (trace) {
 			trace->StartNewTrace();
 		}
 
-		for (auto& replacementAnimation : _replacements) {
+		EvaluationContext context(a_refr, a_clipGenerator, trace);
+
+		for (const auto replacementAnimation : *replacements) {
 			bool bSuccess = replacementAnimation->EvaluateConditions(a_refr, a_clipGenerator);
 			if (bSuccess) {
-				return replacementAnimation.get();
+				return replacementAnimation;
 			}
 		}
+
+		if (bUseNoMatchCache) {
+			OpenAnimationReplacer::GetSingleton().CacheNoMatch(a_refr, this);
+		}
 	}
 
 	return nullptr;
@@ -1313,13 +1332,13 @@ ReplacementAnimation* AnimationReplacements::EvaluateConditionsAndGetReplacement
 
 ReplacementAnimation* AnimationReplacements::EvaluateSynchronizedConditionsAndGetReplacementAnimation(RE::TESObjectREFR* a_sourceRefr, RE::TESObjectREFR* a_targetRefr, RE::hkbClipGenerator* a_clipGenerator) const
 {
-	ReadLocker locker(_lock);
+	const auto replacements = _snapshot.load(std::memory_order_acquire);
 
 	auto& animationLog = AnimationLog::GetSingleton();
 	ReplacementTrace* sourceTrace = animationLog.ShouldLogAnimationsForRefr(a_sourceRefr) ? OpenAnimationReplacer::GetSingleton().GetTraceFromSynchronizedScene(a_sourceRefr) : nullptr;
 	ReplacementTrace* targetTrace = animationLog.ShouldLogAnimationsForRefr(a_targetRefr) ? OpenAnimationReplacer::GetSingleton().GetTraceFromSynchronizedScene(a_targetRefr) : nullptr;
 
-	if (!_replacements.empty()) {
+	if (replacements && !replacements->empty()) {
 		if (sourceTrace) {
 			sourceTrace->StartNewTrace();
 		}
@@ -1327,9 +1346,9 @@ ReplacementAnimation* AnimationReplacements::EvaluateSynchronizedConditionsAndGe
 			targetTrace->StartNewTrace();
 		}
 
-		for (auto& replacementAnimation : _replacements) {
+		for (const auto replacementAnimation : *replacements) {
 			if (replacementAnimation->EvaluateSynchronizedConditions(a_sourceRefr, a_targetRefr, a_clipGenerator)) {
-				return replacementAnimation.get();
+				return replacementAnimation;
 			}
 		}
 	}
@@ -1342,6 +1361,7 @@ void AnimationReplacements::AddReplacementAnimation(std::unique_ptr<ReplacementA
 	WriteLocker locker(_lock);
 
 	_replacements.emplace_back(std::move(a_replacementAnimation));
+	PublishSnapshot();
 }
 
 void AnimationReplacements::SortByPriority()
@@ -1352,6 +1372,7 @@ void AnimationReplacements::SortByPriority()
 		std::ranges::sort(_replacements, [](const auto& a_lhs, const auto& a_rhs) {
 			return a_lhs->GetPriority() > a_rhs->GetPriority();
 		});
+		PublishSnapshot();
 	}
 }
 
@@ -1404,6 +1425,36 @@ void AnimationReplacements::TestReplaceOnEcho()
 	_bOriginalReplaceOnEcho = false;
 }
 
+void AnimationReplacements::TestConditionDependencies()
+{
+	ReadLocker locker(_lock);
+
+	Utils::ConditionDependencies dependencies = Utils::ConditionDependency::kNone;
+
+	for (const auto& replacementAnimation : _replacements) {
+		dependencies.set(Utils::GetConditionSetDependencies(replacementAnimation->GetConditionSet()).get());
+		if (dependencies.all(Utils::ConditionDependency::kUnknown)) {
+			break;
+		}
+	}
+
+	_conditionDependencies.store(dependencies.underlying(), std::memory_order_release);
+}
+
+void AnimationReplacements::PublishSnapshot()
+{
+	auto snapshot = std::make_unique<std::vector<ReplacementAnimation*>>();
+	snapshot->reserve(_replacements.size());
+	for (const auto& replacementAnimation : _replacements) {
+		snapshot->push_back(replacementAnimation.get());
+	}
+
+	// the previous list might still be read by evaluating threads
+	if (const auto previousSnapshot = _snapshot.exchange(snapshot.release(), std::memory_order_acq_rel)) {
+		SnapshotReclaimer::GetSingleton().Retire(std::unique_ptr<const std::vector<ReplacementAnimation*>>(previousSnapshot));
+	}
+}
+
 void AnimationReplacements::MarkAsSynchronizedAnimation(bool a_bSynchronized)
 {
 	_bSynchronized = a_bSynchronized;
@@ -1491,6 +1542,8 @@ void ReplacerProjectData::AddReplacementAnimation(RE::hkbCharacterStringData* a_
 		}
 	}
 
+	_originalIndexesWithReplacements.set(a_originalIndex);
+
 	if (const auto it = originalIndexToAnimationReplacementsMap.find(a_originalIndex); it != originalIndexToAnimationReplacementsMap.end()) {
 		it->second->AddReplacementAnimation(a_replacementAnimation);
 	} else {
@@ -5,6 +5,8 @@
 #include "Parsing.h"
 #include "ReplacementAnimation.h"
 
+#include <bitset>
+
 namespace Jobs
 {
 	struct RemoveSharedRandomFloatJob;
@@ -277,10 +279,13 @@ public:
 	AnimationReplacements(std::string_view a_originalPath) :
 		_originalPath(a_originalPath) {}
 
+	~AnimationReplacements() { delete _snapshot.load(); }
+
 	bool IsEmpty() const { return _replacements.empty(); }
 	std::string_view GetOriginalPath() const { return _originalPath; }
 	bool IsOriginalInterruptible() const { return _bOriginalInterruptible; }
 	bool ShouldOriginalReplaceOnEcho() const { return _bOriginalReplaceOnEcho; }
+	Utils::ConditionDependencies GetConditionDependencies() const { return static_cast<Utils::ConditionDependency>(_conditionDependencies.load(std::memory_order_acquire)); }
 
 	[[nodiscard]] ReplacementAnimation* EvaluateConditionsAndGetReplacementAnimation(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const;
 	[[nodiscard]] ReplacementAnimation* EvaluateSynchronizedConditionsAndGetReplacementAnimation(RE::TESObjectREFR* a_sourceRefr, RE::TESObjectREFR* a_targetRefr, RE::hkbClipGenerator* a_clipGenerator) const;
@@ -292,19 +297,25 @@ public:
 
 	void TestInterruptible();
 	void TestReplaceOnEcho();
+	void TestConditionDependencies();
 
 	void MarkAsSynchronizedAnimation(bool a_bSynchronized);
 
 protected:
+	// builds a new immutable list of the replacements for the lock-free evaluation path, must be called with the write lock held
+	void PublishSnapshot();
+
 	mutable SharedLock _lock;
 
 	std::string _originalPath;
 	std::vector<std::unique_ptr<ReplacementAnimation>> _replacements;
+	std::atomic<const std::vector<ReplacementAnimation*>*> _snapshot = nullptr;
 
 	bool _bSynchronized = false;
 
 	bool _bOriginalInterruptible = false;
 	bool _bOriginalReplaceOnEcho = false;
+	std::atomic<uint32_t> _conditionDependencies = static_cast<uint32_t>(Utils::ConditionDependency::kUnknown);  // written from the UI thread, read from havok threads
 };
 
 // this is a class holding our data per behavior project
@@ -327,6 +338,7 @@ public:
 	[[nodiscard]] uint32_t GetFilteredDuplicateCount() const { return _filteredDuplicates; }
 
 	[[nodiscard]] AnimationReplacements* GetAnimationReplacements(uint16_t a_originalIndex) const;
+	[[nodiscard]] bool HasAnimationReplacements(uint16_t a_originalIndex) const { return _originalIndexesWithReplacements.test(a_originalIndex); }
 
 	void ForEach(const std::function<void(AnimationReplacements*)>& a_func);
 
@@ -342,4 +354,7 @@ public:
 protected:
 	std::unordered_map<std::string, uint16_t> _fileHashToIndexMap;
 	uint32_t _filteredDuplicates = 0;
+
+	// one bit per original animation index, checked on every clip activation before anything is allocated for the clip
+	std::bitset<0x10000> _originalIndexesWithReplacements;
 };
@@ -110,6 +110,30 @@ void Settings::ReadSettings()
 			ReadBoolSetting(ini, "Filtering", "bFilterOutDuplicateAnimations", bFilterOutDuplicateAnimations);
 			//ReadBoolSetting(ini, "Filtering", "bCacheAnimationFileHashes", bCacheAnimationFileHashes);
 
+			// Performance
+			ReadFloatSetting(ini, "Performance", "fInterruptibleEvaluationInterval", fInterruptibleEvaluationInterval);
+			ReadBoolSetting(ini, "Performance", "bScaleInterruptibleEvaluationIntervalWithDistance", bScaleInterruptibleEvaluationIntervalWithDistance);
+			ReadFloatSetting(ini, "Performance", "fInterruptibleEvaluationDistanceStep", fInterruptibleEvaluationDistanceStep);
+			ReadFloatSetting(ini, "Performance", "fInterruptibleEvaluationMaxInterval", fInterruptibleEvaluationMaxInterval);
+			ReadBoolSetting(ini, "Performance", "bTrackConditionDependencies", bTrackConditionDependencies);
+			ReadFloatSetting(ini, "Performance", "fNoMatchCacheLifetime", fNoMatchCacheLifetime);
+			ReadBoolSetting(ini, "Performance", "bCacheInventoryQueries", bCacheInventoryQueries);
+			ReadBoolSetting(ini, "Performance", "bShareActorFacts", bShareActorFacts);
+			ReadFloatSetting(ini, "Performance", "fTargetQueryRefreshInterval", fTargetQueryRefreshInterval);
+			ReadBoolSetting(ini, "Performance", "bShowFrameStatsOverlay", bShowFrameStatsOverlay);
+			ReadBoolSetting(ini, "Performance", "bSinglePassPoseBlending", bSinglePassPoseBlending);
+			ReadFloatSetting(ini, "Performance", "fBlendLayerCullWeight", fBlendLayerCullWeight);
+			ReadUInt32Setting(ini, "Performance", "uMaxBlendLayers", uMaxBlendLayers);
+			ReadBoolSetting(ini, "Performance", "bEnableDistanceLOD", bEnableDistanceLOD);
+			ReadFloatSetting(ini, "Performance", "fLODMidDistance", fLODMidDistance);
+			ReadFloatSetting(ini, "Performance", "fLODFarDistance", fLODFarDistance);
+			ReadFloatSetting(ini, "Performance", "fLODMidEvaluationInterval", fLODMidEvaluationInterval);
+			ReadFloatSetting(ini, "Performance", "fLODFarEvaluationInterval", fLODFarEvaluationInterval);
+			ReadBoolSetting(ini, "Performance", "bLODMidSkipBlending", bLODMidSkipBlending);
+			ReadBoolSetting(ini, "Performance", "bLODFarSkipBlending", bLODFarSkipBlending);
+			ReadBoolSetting(ini, "Performance", "bLODMidSkipTriggerFunctions", bLODMidSkipTriggerFunctions);
+			ReadBoolSetting(ini, "Performance", "bLODFarSkipTriggerFunctions", bLODFarSkipTriggerFunctions);
+
 			// UI
 			ReadBoolSetting(ini, "UI", "bEnableUI", bEnableUI);
 			ReadBoolSetting(ini, "UI", "bShowWelcomeBanner", bShowWelcomeBanner);
@@ -185,6 +209,30 @@ void Settings::WriteSettings()
 	ini.SetBoolValue("Filtering", "bFilterOutDuplicateAnimations", bFilterOutDuplicateAnimations);
 	//ini.SetBoolValue("Filtering", "bCacheAnimationFileHashes", bCacheAnimationFileHashes);
 
+	// Performance
+	ini.SetDoubleValue("Performance", "fInterruptibleEvaluationInterval", fInterruptibleEvaluationInterval);
+	ini.SetBoolValue("Performance", "bScaleInterruptibleEvaluationIntervalWithDistance", bScaleInterruptibleEvaluationIntervalWithDistance);
+	ini.SetDoubleValue("Performance", "fInterruptibleEvaluationDistanceStep", fInterruptibleEvaluationDistanceStep);
+	ini.SetDoubleValue("Performance", "fInterruptibleEvaluationMaxInterval", fInterruptibleEvaluationMaxInterval);
+	ini.SetBoolValue("Performance", "bTrackConditionDependencies", bTrackConditionDependencies);
+	ini.SetDoubleValue("Performance", "fNoMatchCacheLifetime", fNoMatchCacheLifetime);
+	ini.SetBoolValue("Performance", "bCacheInventoryQueries", bCacheInventoryQueries);
+	ini.SetBoolValue("Performance", "bShareActorFacts", bShareActorFacts);
+	ini.SetDoubleValue("Performance", "fTargetQueryRefreshInterval", fTargetQueryRefreshInterval);
+	ini.SetBoolValue("Performance", "bShowFrameStatsOverlay", bShowFrameStatsOverlay);
+	ini.SetBoolValue("Performance", "bSinglePassPoseBlending", bSinglePassPoseBlending);
+	ini.SetDoubleValue("Performance", "fBlendLayerCullWeight", fBlendLayerCullWeight);
+	ini.SetLongValue("Performance", "uMaxBlendLayers", uMaxBlendLayers);
+	ini.SetBoolValue("Performance", "bEnableDistanceLOD", bEnableDistanceLOD);
+	ini.SetDoubleValue("Performance", "fLODMidDistance", fLODMidDistance);
+	ini.SetDoubleValue("Performance", "fLODFarDistance", fLODFarDistance);
+	ini.SetDoubleValue("Performance", "fLODMidEvaluationInterval", fLODMidEvaluationInterval);
+	ini.SetDoubleValue("Performance", "fLODFarEvaluationInterval", fLODFarEvaluationInterval);
+	ini.SetBoolValue("Performance", "bLODMidSkipBlending", bLODMidSkipBlending);
+	ini.SetBoolValue("Performance", "bLODFarSkipBlending", bLODFarSkipBlending);
+	ini.SetBoolValue("Performance", "bLODMidSkipTriggerFunctions", bLODMidSkipTriggerFunctions);
+	ini.SetBoolValue("Performance", "bLODFarSkipTriggerFunctions", bLODFarSkipTriggerFunctions);
+
 	// UI
 	ini.SetBoolValue("UI", "bEnableUI", bEnableUI);
 	ini.SetBoolValue("UI", "bShowWelcomeBanner", bShowWelcomeBanner);
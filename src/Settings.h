@@ -25,6 +25,30 @@ struct Settings
 	static inline bool bFilterOutDuplicateAnimations = true;
 	//static inline bool bCacheAnimationFileHashes = false;
 
+	// Performance
+	static inline float fInterruptibleEvaluationInterval = 0.f;
+	static inline bool bScaleInterruptibleEvaluationIntervalWithDistance = false;
+	static inline float fInterruptibleEvaluationDistanceStep = 1000.f;
+	static inline float fInterruptibleEvaluationMaxInterval = 1.f;
+	static inline bool bTrackConditionDependencies = false;
+	static inline float fNoMatchCacheLifetime = 0.f;
+	static inline bool bCacheInventoryQueries = false;
+	static inline bool bShareActorFacts = false;
+	static inline float fTargetQueryRefreshInterval = 0.f;
+	static inline bool bShowFrameStatsOverlay = false;
+	static inline bool bSinglePassPoseBlending = false;
+	static inline float fBlendLayerCullWeight = 0.f;
+	static inline uint32_t uMaxBlendLayers = 8;
+	static inline bool bEnableDistanceLOD = false;
+	static inline float fLODMidDistance = 2000.f;
+	static inline float fLODFarDistance = 4000.f;
+	static inline float fLODMidEvaluationInterval = 0.1f;
+	static inline float fLODFarEvaluationInterval = 0.5f;
+	static inline bool bLODMidSkipBlending = false;
+	static inline bool bLODFarSkipBlending = true;
+	static inline bool bLODMidSkipTriggerFunctions = false;
+	static inline bool bLODFarSkipTriggerFunctions = true;
+
 	// UI
 	static inline bool bEnableUI = true;
 	static inline bool bShowWelcomeBanner = true;
@@ -1,5 +1,8 @@
 #include "SharedTypes.h"
 
+#include "AnimationLog.h"
+#include "GraphVariableCache.h"
+#include "OpenAnimationReplacer.h"
 #include "ReplacementAnimation.h"
 #include "ReplacerMods.h"
 
@@ -48,6 +51,15 @@ void ReplacementTrace::EndTracingMultiCondition(Conditions::ICondition* a_condit
 	}
 }
 
+ReplacementTrace* EvaluationContext::ResolveTrace(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator)
+{
+	if (_current && _current->_refr == a_refr && _current->_clipGenerator == a_clipGenerator) {
+		return _current->_trace;
+	}
+
+	return AnimationLog::GetSingleton().ShouldLogAnimationsForRefr(a_refr) ? OpenAnimationReplacer::GetSingleton().GetTrace(a_refr, a_clipGenerator) : nullptr;
+}
+
 namespace Components
 {
 	float NumericValue::GetValue(RE::TESObjectREFR* a_refr) const
@@ -85,19 +97,19 @@ namespace Components
 					case GraphVariableType::kFloat:
 						{
 							float outValue = 0.f;
-							a_refr->GetGraphVariableFloat(_graphVariableName.GetValue(), outValue);
+							GraphVariableCache::GetSingleton().GetFloat(a_refr, _graphVariableName.GetFixedValue(), outValue);
 							return outValue;
 						}
 					case GraphVariableType::kInt:
 						{
 							int32_t outValue = 0;
-							a_refr->GetGraphVariableInt(_graphVariableName.GetValue(), outValue);
+							GraphVariableCache::GetSingleton().GetInt(a_refr, _graphVariableName.GetFixedValue(), outValue);
 							return static_cast<float>(outValue);
 						}
 					case GraphVariableType::kBool:
 						{
 							bool outValue;
-							a_refr->GetGraphVariableBool(_graphVariableName.GetValue(), outValue);
+							GraphVariableCache::GetSingleton().GetBool(a_refr, _graphVariableName.GetFixedValue(), outValue);
 							return outValue;
 						}
 					}
@@ -545,6 +557,7 @@ namespace Components
 				flags |= ImGuiInputTextFlags_CharsNoBlank;
 			}
 			if (ImGui::InputTextWithHint("##Text", _uiTextHint.data(), &_text, flags)) {
+				_fixedText = _text;
 				bEdited = true;
 			}
 			ImGui::PopID();
@@ -558,6 +571,7 @@ namespace Components
 	void TextValue::Parse(const rapidjson::Value& a_value)
 	{
 		_text = (a_value.GetString());
+		_fixedText = _text;
 	}
 
 	rapidjson::Value TextValue::Serialize([[maybe_unused]] rapidjson::Document::AllocatorType& a_allocator) const
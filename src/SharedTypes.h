@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Containers.h"
 #include "UI/UICommon.h"
 #include "Utils.h"
 
@@ -68,6 +69,35 @@ struct ReplacementTrace
 	std::stack<std::vector<Step::ConditionEntry>> childStack{};
 };
 
+// holds the trace resolved at the start of an evaluation, so nested condition sets evaluated on the same thread don't have to look it up again
+class EvaluationContext
+{
+public:
+	EvaluationContext(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator, ReplacementTrace* a_trace) :
+		_refr(a_refr), _clipGenerator(a_clipGenerator), _trace(a_trace), _previous(_current)
+	{
+		_current = this;
+	}
+
+	~EvaluationContext() { _current = _previous; }
+
+	EvaluationContext(const EvaluationContext&) = delete;
+	EvaluationContext(EvaluationContext&&) = delete;
+	EvaluationContext& operator=(const EvaluationContext&) = delete;
+	EvaluationContext& operator=(EvaluationContext&&) = delete;
+
+	// returns the trace from the current context if it was created for the same refr and clip, otherwise looks it up
+	[[nodiscard]] static ReplacementTrace* ResolveTrace(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator);
+
+private:
+	RE::TESObjectREFR* _refr;
+	RE::hkbClipGenerator* _clipGenerator;
+	ReplacementTrace* _trace;
+	EvaluationContext* _previous;
+
+	static inline thread_local EvaluationContext* _current = nullptr;
+};
+
 namespace Components
 {
 	template <Derived<RE::TESForm> T>
@@ -228,7 +258,13 @@ namespace Components
 	{
 	public:
 		[[nodiscard]] std::string_view GetValue() const { return _text; }
-		void SetValue(std::string_view a_text) { _text = a_text; }
+		// pooled copy of the text, so hot lookups by name (e.g. graph variables) skip the string pool every call
+		[[nodiscard]] const RE::BSFixedString& GetFixedValue() const { return _fixedText; }
+		void SetValue(std::string_view a_text)
+		{
+			_text = a_text;
+			_fixedText = _text;
+		}
 		void SetTextHint(std::string_view a_text) { _uiTextHint = a_text; }
 
 		bool DisplayInUI(bool a_bEditable, float a_firstColumnWidthPercent);
@@ -241,6 +277,7 @@ namespace Components
 
 	protected:
 		std::string _text{};
+		RE::BSFixedString _fixedText{};
 		std::string _uiTextHint = "Text...";
 		bool _bAllowSpaces = true;
 	};
@@ -463,19 +500,27 @@ namespace Components
 		KeywordValue(const KeywordValue& a_rhs) :
 			_type(a_rhs._type),
 			_keywordForm(a_rhs._keywordForm),
-			_keywordLiteral(a_rhs._keywordLiteral),
-			_keywordFormsMatchingLiteral(a_rhs._keywordFormsMatchingLiteral) {}
+			_keywordLiteral(a_rhs._keywordLiteral)
+		{
+			if (const auto literalMatches = a_rhs._literalMatches.load(std::memory_order_acquire)) {
+				_literalMatches = new LiteralMatches(*literalMatches);
+			}
+		}
 
 		KeywordValue& operator=(KeywordValue&& a_rhs) noexcept
 		{
 			_type = a_rhs._type;
 			_keywordLiteral = a_rhs._keywordLiteral;
 			_keywordForm = a_rhs._keywordForm;
-			_keywordFormsMatchingLiteral = a_rhs._keywordFormsMatchingLiteral;
+
+			const auto literalMatches = a_rhs._literalMatches.load(std::memory_order_acquire);
+			PublishLiteralMatches(literalMatches ? std::make_unique<LiteralMatches>(*literalMatches) : nullptr);
 
 			return *this;
 		}
 
+		~KeywordValue() { delete _literalMatches.load(); }
+
 		enum class Type : uint8_t
 		{
 			kLiteral,
@@ -487,30 +532,38 @@ namespace Components
 			if (_keywordForm.IsValid()) {
 				return true;
 			}
-			ReadLocker locker(_dataLock);
-			return !_keywordFormsMatchingLiteral.empty();
+			return HasLiteralMatches();
 		}
 
 		T* GetFormValue() const { return _keywordForm.GetValue(); }
 
 		bool HasKeyword(const RE::BGSKeywordForm* a_keywordForm) const
 		{
-			bool bFound = false;
-			ForEachKeyword([&](T* a_keyword) {
-				if (a_keywordForm->HasKeyword(a_keyword)) {
-					bFound = true;
-					return RE::BSContainer::ForEachResult::kStop;
+			if (_type == Type::kForm) {
+				return _keywordForm.IsValid() && a_keywordForm->HasKeyword(_keywordForm.GetValue());
+			}
+
+			const auto literalMatches = _literalMatches.load(std::memory_order_acquire);
+			if (!literalMatches) {
+				return false;
+			}
+
+			// forms only have a few keywords, so binary search each of them in the sorted list of matching IDs
+			for (uint32_t i = 0; i < a_keywordForm->numKeywords; ++i) {
+				if (const auto keyword = a_keywordForm->keywords[i]; keyword && std::ranges::binary_search(literalMatches->sortedFormIDs, keyword->GetFormID())) {
+					return true;
 				}
-				return RE::BSContainer::ForEachResult::kContinue;
-			});
+			}
 
-			return bFound;
+			return false;
 		}
 
+		[[nodiscard]] bool HasLiteralMatches() const { return _literalMatches.load(std::memory_order_acquire) != nullptr; }
+
 		void SetKeyword(T* a_keyword)
 		{
 			WriteLocker locker(_dataLock);
-			_keywordFormsMatchingLiteral.clear();
+			PublishLiteralMatches(nullptr);
 
 			_type = Type::kForm;
 			_keywordForm.SetValue(a_keyword);
@@ -554,7 +607,7 @@ namespace Components
 						bEdited = true;
 					}
 					UI::UICommon::SecondColumn(a_firstColumnWidthPercent);
-					if (_keywordFormsMatchingLiteral.size() > 0) {
+					if (HasLiteralMatches()) {
 						std::string formIDs{};
 						bool bIsFirst = true;
 						ForEachKeyword([&](auto a_kywd) {
@@ -581,7 +634,7 @@ namespace Components
 				case Type::kLiteral:
 					ImGui::TextUnformatted(_keywordLiteral.data());
 					UI::UICommon::SecondColumn(a_firstColumnWidthPercent);
-					if (_keywordFormsMatchingLiteral.size() > 0) {
+					if (HasLiteralMatches()) {
 						std::string formIDs{};
 						bool bIsFirst = true;
 						ForEachKeyword([&](auto a_kywd) {
@@ -667,15 +720,19 @@ namespace Components
 		{
 			WriteLocker locker(_dataLock);
 			_keywordForm.SetValue(nullptr);
-			_keywordFormsMatchingLiteral.clear();
 			_type = Type::kLiteral;
 
+			auto literalMatches = std::make_unique<LiteralMatches>();
 			auto& keywords = RE::TESDataHandler::GetSingleton()->GetFormArray<T>();
 			for (auto& kywd : keywords) {
 				if (kywd && kywd->formEditorID == std::string_view(_keywordLiteral)) {
-					_keywordFormsMatchingLiteral.emplace_back(kywd);
+					literalMatches->keywords.emplace_back(kywd);
+					literalMatches->sortedFormIDs.emplace_back(kywd->GetFormID());
 				}
 			}
+			std::ranges::sort(literalMatches->sortedFormIDs);
+
+			PublishLiteralMatches(literalMatches->keywords.empty() ? nullptr : std::move(literalMatches));
 		}
 
 		void ForEachKeyword(std::function<RE::BSContainer::ForEachResult(T*)> a_callback) const
@@ -687,15 +744,30 @@ namespace Components
 				return;
 			}
 
-			ReadLocker locker(_dataLock);
-			for (auto& kywd : _keywordFormsMatchingLiteral) {
-				if (a_callback(kywd) == RE::BSContainer::ForEachResult::kStop) {
-					return;
+			if (const auto literalMatches = _literalMatches.load(std::memory_order_acquire)) {
+				for (auto& kywd : literalMatches->keywords) {
+					if (a_callback(kywd) == RE::BSContainer::ForEachResult::kStop) {
+						return;
+					}
 				}
 			}
 		}
 
 	protected:
+		// keywords with an editor ID matching the literal, replaced as a whole when the literal changes so the read path doesn't need a lock
+		struct LiteralMatches
+		{
+			std::vector<T*> keywords;
+			std::vector<RE::FormID> sortedFormIDs;
+		};
+
+		void PublishLiteralMatches(std::unique_ptr<LiteralMatches> a_literalMatches)
+		{
+			if (const auto previousLiteralMatches = _literalMatches.exchange(a_literalMatches.release(), std::memory_order_acq_rel)) {
+				SnapshotReclaimer::GetSingleton().Retire(std::unique_ptr<const LiteralMatches>(previousLiteralMatches));
+			}
+		}
+
 		static int KeywordInputTextCallback(struct ImGuiInputTextCallbackData* a_data)
 		{
 			auto* value = static_cast<KeywordValue*>(a_data->UserData);
@@ -711,7 +783,7 @@ namespace Components
 
 		std::string _keywordLiteral{};
 		mutable SharedLock _dataLock{};
-		std::vector<T*> _keywordFormsMatchingLiteral{};
+		std::atomic<const LiteralMatches*> _literalMatches = nullptr;
 	};
 
 }
@@ -0,0 +1,100 @@
+#include "TargetCache.h"
+
+#include "OpenAnimationReplacer.h"
+#include "Settings.h"
+
+bool TargetCache::GetCurrentTarget(RE::Actor* a_actor, Utils::TargetType a_targetType, RE::TESObjectREFRPtr& a_outPtr)
+{
+	if (Settings::fTargetQueryRefreshInterval <= 0.f || !a_actor) {
+		return Utils::GetCurrentTarget(a_actor, a_targetType, a_outPtr);
+	}
+
+	const TargetKey key{ Utils::RefrKey(a_actor), a_targetType };
+	const float currentTime = OpenAnimationReplacer::gameTimeCounter;
+
+	{
+		ReadLocker locker(_lock);
+
+		if (const auto it = _targets.find(key); it != _targets.end() && it->second.expiryTime > currentTime) {
+			// the cached target might have been unloaded since
+			if (!it->second.bHasTarget) {
+				++targetHitCount;
+				return false;
+			}
+			if (auto target = it->second.target.get()) {
+				++targetHitCount;
+				a_outPtr = std::move(target);
+				return true;
+			}
+		}
+	}
+
+	++targetMissCount;
+	const bool bHasTarget = Utils::GetCurrentTarget(a_actor, a_targetType, a_outPtr);
+
+	WriteLocker locker(_lock);
+
+	PurgeExpired();
+	_targets.insert_or_assign(key, CachedTarget{ bHasTarget && a_outPtr ? a_outPtr->GetHandle() : RE::ObjectRefHandle(), bHasTarget, currentTime + Settings::fTargetQueryRefreshInterval });
+
+	return bHasTarget;
+}
+
+bool TargetCache::HasLineOfSight(RE::Actor* a_actor, RE::TESObjectREFR* a_target)
+{
+	if (!a_actor || !a_target) {
+		return false;
+	}
+
+	bool bUnk = false;
+	if (Settings::fTargetQueryRefreshInterval <= 0.f) {
+		return a_actor->HasLineOfSight(a_target, bUnk);
+	}
+
+	const LineOfSightKey key{ Utils::RefrKey(a_actor), Utils::RefrKey(a_target) };
+	const float currentTime = OpenAnimationReplacer::gameTimeCounter;
+
+	{
+		ReadLocker locker(_lock);
+
+		if (const auto it = _linesOfSight.find(key); it != _linesOfSight.end() && it->second.expiryTime > currentTime) {
+			++lineOfSightHitCount;
+			return it->second.bHasLineOfSight;
+		}
+	}
+
+	++lineOfSightMissCount;
+	const bool bHasLineOfSight = a_actor->HasLineOfSight(a_target, bUnk);
+
+	WriteLocker locker(_lock);
+
+	PurgeExpired();
+	_linesOfSight.insert_or_assign(key, CachedLineOfSight{ bHasLineOfSight, currentTime + Settings::fTargetQueryRefreshInterval });
+
+	return bHasLineOfSight;
+}
+
+void TargetCache::Clear()
+{
+	WriteLocker locker(_lock);
+
+	_targets.clear();
+	_linesOfSight.clear();
+}
+
+void TargetCache::PurgeExpired()
+{
+	const float currentTime = OpenAnimationReplacer::gameTimeCounter;
+	if (currentTime < _nextPurgeTime) {
+		return;
+	}
+
+	_nextPurgeTime = currentTime + std::max(Settings::fTargetQueryRefreshInterval, 1.f);
+
+	std::erase_if(_targets, [currentTime](const auto& a_entry) {
+		return a_entry.second.expiryTime <= currentTime;
+	});
+	std::erase_if(_linesOfSight, [currentTime](const auto& a_entry) {
+		return a_entry.second.expiryTime <= currentTime;
+	});
+}
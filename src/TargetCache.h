@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Utils.h"
+
+// remembers the current target and line of sight queries of actors for a short while, shared by all target conditions
+class TargetCache final
+{
+public:
+	static TargetCache& GetSingleton()
+	{
+		static TargetCache singleton;
+		return singleton;
+	}
+
+	[[nodiscard]] bool GetCurrentTarget(RE::Actor* a_actor, Utils::TargetType a_targetType, RE::TESObjectREFRPtr& a_outPtr);
+	[[nodiscard]] bool HasLineOfSight(RE::Actor* a_actor, RE::TESObjectREFR* a_target);
+
+	void Clear();
+
+	static inline std::atomic_uint64_t targetHitCount = 0;
+	static inline std::atomic_uint64_t targetMissCount = 0;
+	static inline std::atomic_uint64_t lineOfSightHitCount = 0;
+	static inline std::atomic_uint64_t lineOfSightMissCount = 0;
+
+private:
+	TargetCache() = default;
+	TargetCache(const TargetCache&) = delete;
+	TargetCache(TargetCache&&) = delete;
+	~TargetCache() = default;
+
+	TargetCache& operator=(const TargetCache&) = delete;
+	TargetCache& operator=(TargetCache&&) = delete;
+
+	struct CachedTarget
+	{
+		RE::ObjectRefHandle target;
+		bool bHasTarget;
+		float expiryTime;
+	};
+
+	struct CachedLineOfSight
+	{
+		bool bHasLineOfSight;
+		float expiryTime;
+	};
+
+	// called with the write lock held
+	void PurgeExpired();
+
+	// keyed by refr pointer and form id so lookups don't go through the handle manager
+	using TargetKey = std::pair<Utils::RefrKey, Utils::TargetType>;
+	using LineOfSightKey = std::pair<Utils::RefrKey, Utils::RefrKey>;
+
+	mutable SharedLock _lock;
+	std::unordered_map<TargetKey, CachedTarget, KeyHash<TargetKey>> _targets;
+	std::unordered_map<LineOfSightKey, CachedLineOfSight, KeyHash<LineOfSightKey>> _linesOfSight;
+	float _nextPurgeTime = 0.f;
+};
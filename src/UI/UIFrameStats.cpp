@@ -0,0 +1,92 @@
+#include "UIFrameStats.h"
+#include "FrameStats.h"
+#include "Settings.h"
+
+namespace UI
+{
+	bool UIFrameStats::ShouldDrawImpl() const
+	{
+		return Settings::bShowFrameStatsOverlay;
+	}
+
+	void UIFrameStats::DrawImpl()
+	{
+		const auto frames = FrameStats::GetSingleton().GetFrames();
+
+		constexpr ImGuiWindowFlags windowFlags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove;
+
+		constexpr float PAD = 10.0f;
+		const ImGuiViewport* viewport = ImGui::GetMainViewport();
+		ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + PAD, viewport->WorkPos.y + PAD), ImGuiCond_Always);
+		ImGui::SetNextWindowBgAlpha(0.5f);
+
+		if (ImGui::Begin("FrameStats", nullptr, windowFlags)) {
+			ImGui::TextUnformatted("OAR frame budget");
+
+			if (frames.empty()) {
+				ImGui::TextUnformatted("Waiting for frames...");
+			} else {
+				const float frameCount = static_cast<float>(frames.size());
+
+				// per frame totals, also used for the plot
+				std::vector<float> totalMilliseconds;
+				totalMilliseconds.reserve(frames.size());
+				for (const auto& frame : frames) {
+					totalMilliseconds.emplace_back(static_cast<float>(frame.GetTotalNanoseconds()) / 1000000.f);
+				}
+
+				if (ImGui::BeginTable("FrameStatsTable", 3, ImGuiTableFlags_SizingFixedFit)) {
+					ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed, 170.f);
+					ImGui::TableSetupColumn("Avg", ImGuiTableColumnFlags_WidthFixed, 70.f);
+					ImGui::TableSetupColumn("Max", ImGuiTableColumnFlags_WidthFixed, 70.f);
+					ImGui::TableHeadersRow();
+
+					const auto drawRow = [](std::string_view a_name, float a_average, float a_max, std::string_view a_format) {
+						ImGui::TableNextRow();
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted(a_name.data());
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted(std::vformat(a_format, std::make_format_args(a_average)).data());
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted(std::vformat(a_format, std::make_format_args(a_max)).data());
+					};
+
+					for (size_t i = 0; i < FrameStats::phaseCount; ++i) {
+						float sum = 0.f;
+						float max = 0.f;
+						for (const auto& frame : frames) {
+							const float milliseconds = static_cast<float>(frame.phaseNanoseconds[i]) / 1000000.f;
+							sum += milliseconds;
+							max = std::max(max, milliseconds);
+						}
+						drawRow(FrameStats::GetPhaseName(static_cast<FrameStats::Phase>(i)), sum / frameCount, max, "{:.3f} ms"sv);
+					}
+
+					float totalSum = 0.f;
+					float totalMax = 0.f;
+					for (const auto milliseconds : totalMilliseconds) {
+						totalSum += milliseconds;
+						totalMax = std::max(totalMax, milliseconds);
+					}
+					drawRow("Total"sv, totalSum / frameCount, totalMax, "{:.3f} ms"sv);
+
+					for (size_t i = 0; i < FrameStats::counterCount; ++i) {
+						float sum = 0.f;
+						float max = 0.f;
+						for (const auto& frame : frames) {
+							const auto count = static_cast<float>(frame.counters[i]);
+							sum += count;
+							max = std::max(max, count);
+						}
+						drawRow(FrameStats::GetCounterName(static_cast<FrameStats::Counter>(i)), sum / frameCount, max, "{:.1f}"sv);
+					}
+
+					ImGui::EndTable();
+				}
+
+				ImGui::PlotLines("##FrameStatsPlot", totalMilliseconds.data(), static_cast<int>(totalMilliseconds.size()), 0, nullptr, 0.f, FLT_MAX, ImVec2(310.f, 50.f));
+			}
+		}
+		ImGui::End();
+	}
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include "UIWindow.h"
+
+namespace UI
+{
+	class UIFrameStats : public UIWindow
+	{
+	protected:
+		bool ShouldDrawImpl() const override;
+		void DrawImpl() override;
+	};
+}
@@ -4,10 +4,13 @@
 #include <imgui_stdlib.h>
 
 #include "ActiveClip.h"
+#include "ActorFacts.h"
 #include "DetectedProblems.h"
+#include "InventoryCache.h"
 #include "Jobs.h"
 #include "OpenAnimationReplacer.h"
 #include "Parsing.h"
+#include "TargetCache.h"
 #include "UICommon.h"
 #include "UIManager.h"
 
@@ -73,6 +76,10 @@ namespace UI
 						DrawReplacementAnimations();
 						ImGui::EndTabItem();
 					}
+					if (ImGui::BeginTabItem("Profiler")) {
+						DrawProfiler();
+						ImGui::EndTabItem();
+					}
 
 					ImGui::EndTabBar();
 				}
@@ -305,6 +312,13 @@ namespace UI
 	void UIMain::OnClose()
 	{
 		UIManager::GetSingleton().RemoveInputConsumer();
+
+		if (Settings::bTrackConditionDependencies) {
+			OpenAnimationReplacer::GetSingleton().UpdateConditionDependencies();
+		}
+
+		// conditions might have been edited
+		OpenAnimationReplacer::GetSingleton().ClearNoMatchCache();
 	}
 
 	void UIMain::DrawSettings(const ImVec2& a_pos)
@@ -416,6 +430,207 @@ namespace UI
 			ImGui::Spacing();
 			ImGui::Separator();
 
+			// Performance settings
+			ImGui::AlignTextToFramePadding();
+			ImGui::TextUnformatted("Performance Settings");
+			ImGui::Spacing();
+
+			if (ImGui::SliderFloat("Interruptible evaluation interval", &Settings::fInterruptibleEvaluationInterval, 0.f, 1.f, "%.2f s", ImGuiSliderFlags_AlwaysClamp)) {
+				Settings::WriteSettings();
+			}
+			ImGui::SameLine();
+			UICommon::HelpMarker("Minimum time between condition re-evaluations of active interruptible animations. At 0, conditions are re-evaluated on every update. Higher values reduce the per-frame cost with many actors, at the cost of slightly delayed interrupts. Re-evaluations are staggered across actors.");
+
+			ImGui::BeginDisabled(Settings::fInterruptibleEvaluationInterval <= 0.f);
+			if (ImGui::Checkbox("Scale interval with distance", &Settings::bScaleInterruptibleEvaluationIntervalWithDistance)) {
+				Settings::WriteSettings();
+			}
+			ImGui::SameLine();
+			UICommon::HelpMarker("Enable to increase the interruptible evaluation interval for actors further away from the camera.");
+
+			ImGui::BeginDisabled(!Settings::bScaleInterruptibleEvaluationIntervalWithDistance);
+			if (ImGui::SliderFloat("Distance step", &Settings::fInterruptibleEvaluationDistanceStep, 100.f, 5000.f, "%.0f", ImGuiSliderFlags_AlwaysClamp)) {
+				Settings::WriteSettings();
+			}
+			ImGui::SameLine();
+			UICommon::HelpMarker("The interval is increased by its base value for every step of this distance between the actor and the camera.");
+
+			if (ImGui::SliderFloat("Max interval", &Settings::fInterruptibleEvaluationMaxInterval, 0.f, 5.f, "%.2f s", ImGuiSliderFlags_AlwaysClamp)) {
+				Settings::WriteSettings();
+			}
+			ImGui::SameLine();
+			UICommon::HelpMarker("Upper limit of the distance-scaled interruptible evaluation interval.");
+			ImGui::EndDisabled();
+			ImGui::EndDisabled();
+
+			if (ImGui::Checkbox("Track condition dependencies", &Settings::bTrackConditionDependencies)) {
+				if (Settings::bTrackConditionDependencies) {
+					OpenAnimationReplacer::GetSingleton().UpdateConditionDependencies();
+				}
+				Settings::WriteSettings();
+			}
+			ImGui::SameLine();
+			UICommon::HelpMarker("Enable to only re-evaluate active interruptible animations when something their conditions depend on has changed for the actor (equipment, animation graph events, combat state, active magic effects, game time). Animations with any condition of an unknown dependency are still re-evaluated every update. Not applied while this menu is open.");
+
+			if (Settings::bTrackConditionDependencies) {
+				const uint64_t evaluated = OpenAnimationReplacer::interruptibleEvaluationCount;
+				const uint64_t skipped = OpenAnimationReplacer::skippedInterruptibleEvaluationCount;
+				ImGui::TextUnformatted(std::format("Skipped re-evaluations: {} / {}", skipped, evaluated + skipped).data());
+			}
+
+			if (ImGui::SliderFloat("No match cache lifetime", &Settings::fNoMatchCacheLifetime, 0.f, 5.f, "%.2f s", ImGuiSliderFlags_AlwaysClamp)) {
+				OpenAnimationReplacer::GetSingleton().ClearNoMatchCache();
+				Settings::WriteSettings();
+			}
+			ImGui::SameLine();
+			UICommon::HelpMarker("When none of the replacements of an animation match for an actor, remember that result for this long and skip evaluating the conditions again. The result is forgotten earlier when mods are toggled or reordered, when this menu is closed, or when the actor's equipment or 3D changes. At 0, the cache is disabled. Not applied while this menu is open or while the animation log is tracing the actor.");
+
+			if (Settings::fNoMatchCacheLifetime > 0.f) {
+				const uint64_t hits = OpenAnimationReplacer::noMatchCacheHitCount;
+				const uint64_t misses = OpenAnimationReplacer::noMatchCacheMissCount;
+				const uint64_t total = hits + misses;
+				ImGui::TextUnformatted(std::format("No match cache hits: {} / {} ({:.1f}%)", hits, total, total > 0 ? static_cast<double>(hits) * 100.0 / static_cast<double>(total) : 0.0).data());
+			}
+
+			if (ImGui::Checkbox("Cache inventory queries", &Settings::bCacheInventoryQueries)) {
+				InventoryCache::GetSingleton().Clear();
+				Settings::WriteSettings();
+			}
+			ImGui::SameLine();
+			UICommon::HelpMarker("Enable to remember the results of the IsWorn and InventoryCount conditions per actor until the actor's inventory, equipment or 3D changes.");
+
+			if (ImGui::Checkbox("Share actor facts", &Settings::bShareActorFacts)) {
+				ActorFactCache::GetSingleton().Clear();
+				Settings::WriteSettings();
+			}
+			ImGui::SameLine();
+			UICommon::HelpMarker("Enable to read common actor state (sex, level, combat, weapon drawn, sneaking, sprinting, in air, on mount, light level, surface material) at most once per frame per actor, no matter how many conditions check it. Changes made later in the same frame are only seen on the next frame, except for the combat state.");
+
+			if (Settings::bShareActorFacts && ImGui::TreeNode("Actor fact hits")) {
+				for (size_t i = 0; i < ActorFacts::factCount; ++i) {
+					const auto fact = static_cast<ActorFacts::Fact>(i);
+					const uint64_t hits = ActorFacts::GetHitCount(fact);
+					const uint64_t total = hits + ActorFacts::GetMissCount(fact);
+					ImGui::TextUnformatted(std::format("{}: {} / {}", ActorFacts::GetFactName(fact), hits, total).data());
+				}
+				ImGui::TreePop();
+			}
+
+			if (ImGui::SliderFloat("Target query refresh interval", &Settings::fTargetQueryRefreshInterval, 0.f, 1.f, "%.2f s", ImGuiSliderFlags_AlwaysClamp)) {
+				TargetCache::GetSingleton().Clear();
+				Settings::WriteSettings();
+			}
+			ImGui::SameLine();
+			UICommon::HelpMarker("Time for which the current target and line of sight results of an actor are shared by all target conditions before being queried again. Line of sight checks are raycasts, so this helps with many submods gated on them. At 0, every condition queries them directly.");
+
+			if (Settings::fTargetQueryRefreshInterval > 0.f) {
+				const uint64_t targetHits = TargetCache::targetHitCount;
+				const uint64_t targetMisses = TargetCache::targetMissCount;
+				const uint64_t lineOfSightHits = TargetCache::lineOfSightHitCount;
+				const uint64_t lineOfSightMisses = TargetCache::lineOfSightMissCount;
+				ImGui::TextUnformatted(std::format("Target cache hits: {} / {}", targetHits, targetHits + targetMisses).data());
+				ImGui::TextUnformatted(std::format("Line of sight cache hits: {} / {} (raycasts: {})", lineOfSightHits, lineOfSightHits + lineOfSightMisses, lineOfSightMisses).data());
+			}
+
+			if (ImGui::Checkbox("Show frame budget overlay", &Settings::bShowFrameStatsOverlay)) {
+				Settings::WriteSettings();
+			}
+			ImGui::SameLine();
+			UICommon::HelpMarker("Enable to show an overlay with the time spent per frame in each of the animation hooks (excluding the game's own work), averaged over the last frames along with the worst frame, and the number of clip activations and condition evaluations per frame. Measuring adds a small cost to every hook call.");
+
+			if (ImGui::Checkbox("Single pass pose blending", &Settings::bSinglePassPoseBlending)) {
+				Settings::WriteSettings();
+			}
+			ImGui::SameLine();
+			UICommon::HelpMarker("Enable to blend all the poses of an interrupted animation with its replacement in a single pass over the bones, instead of calling the game's pose blending once per blending animation.");
+
+			if (ImGui::SliderFloat("Blend layer cull weight", &Settings::fBlendLayerCullWeight, 0.f, 0.1f, "%.3f", ImGuiSliderFlags_AlwaysClamp)) {
+				Settings::WriteSettings();
+			}
+			ImGui::SameLine();
+			UICommon::HelpMarker("Interrupted animations that are still blending out stop being updated and sampled once their weight in the final pose, after the newer blends on top of them, falls below this. At 0, they blend out fully.");
+
+			constexpr uint32_t blendLayersMin = 1;
+			constexpr uint32_t blendLayersMax = static_cast<uint32_t>(ActiveClip::maxBlendingClips);
+			if (ImGui::SliderScalar("Max blend layers", ImGuiDataType_U32, &Settings::uMaxBlendLayers, &blendLayersMin, &blendLayersMax, "%d", ImGuiSliderFlags_AlwaysClamp)) {
+				Settings::WriteSettings();
+			}
+			ImGui::SameLine();
+			UICommon::HelpMarker("Maximum number of interrupted animations blending out at the same time per clip. Interrupting again drops the oldest one.");
+
+			ImGui::TextUnformatted(std::format("Culled blend layers: {}", ActiveClip::culledBlendingClipCount.load()).data());
+
+			if (ImGui::Checkbox("Distance level of detail", &Settings::bEnableDistanceLOD)) {
+				Settings::WriteSettings();
+			}
+			ImGui::SameLine();
+			UICommon::HelpMarker("Enable to do less work for the animations of actors far from the camera. Actors past the mid or far distance re-evaluate interruptible animations at most at the set interval, and can skip blending when an animation is interrupted and skip OnTrigger functions.");
+
+			if (Settings::bEnableDistanceLOD && ImGui::TreeNode("Level of detail tiers")) {
+				const auto drawTier = [](const char* a_label, float& a_distance, float& a_evaluationInterval, bool& a_bSkipBlending, bool& a_bSkipTriggerFunctions) {
+					ImGui::PushID(a_label);
+					ImGui::TextUnformatted(a_label);
+					if (ImGui::SliderFloat("Distance", &a_distance, 0.f, 10000.f, "%.0f", ImGuiSliderFlags_AlwaysClamp)) {
+						Settings::WriteSettings();
+					}
+					if (ImGui::SliderFloat("Evaluation interval", &a_evaluationInterval, 0.f, 2.f, "%.2f s", ImGuiSliderFlags_AlwaysClamp)) {
+						Settings::WriteSettings();
+					}
+					if (ImGui::Checkbox("Skip blending", &a_bSkipBlending)) {
+						Settings::WriteSettings();
+					}
+					if (ImGui::Checkbox("Skip OnTrigger functions", &a_bSkipTriggerFunctions)) {
+						Settings::WriteSettings();
+					}
+					ImGui::PopID();
+				};
+
+				drawTier("Mid", Settings::fLODMidDistance, Settings::fLODMidEvaluationInterval, Settings::bLODMidSkipBlending, Settings::bLODMidSkipTriggerFunctions);
+				drawTier("Far", Settings::fLODFarDistance, Settings::fLODFarEvaluationInterval, Settings::bLODFarSkipBlending, Settings::bLODFarSkipTriggerFunctions);
+
+				std::array<std::unordered_set<RE::TESObjectREFR*>, static_cast<size_t>(ActiveClip::LODTier::kTotal)> refrsPerTier;
+				OpenAnimationReplacer::GetSingleton().ForEachActiveClip([&](ActiveClip* a_activeClip) {
+					refrsPerTier[static_cast<size_t>(a_activeClip->GetLODTier())].emplace(a_activeClip->GetRefr());
+				});
+				ImGui::TextUnformatted(std::format("Actors: {} near, {} mid, {} far", refrsPerTier[0].size(), refrsPerTier[1].size(), refrsPerTier[2].size()).data());
+
+				ImGui::TreePop();
+			}
+
+			if (ImGui::TreeNode("Allocations")) {
+				const auto drawPool = [](std::string_view a_name, const auto& a_pool) {
+					ImGui::TextUnformatted(std::format("{}: {} in use (peak {}, capacity {})", a_name, a_pool.GetCurrentCount(), a_pool.GetPeakCount(), a_pool.GetCapacity()).data());
+				};
+				drawPool("Active clips"sv, BlockPool<ActiveClip>::GetSingleton());
+				drawPool("Blending clips"sv, BlockPool<ActiveClip::BlendingClip>::GetSingleton());
+				ImGui::TextUnformatted(std::format("Blend scratch buffer growths: {}", ActiveClip::blendScratchBufferGrowCount.load()).data());
+				ImGui::TreePop();
+			}
+
+#ifdef USE_INSTRUMENTED_LOCKS
+			if (ImGui::TreeNode("Lock statistics")) {
+				if (ImGui::Button("Log")) {
+					LockStats::LogStats();
+				}
+				ImGui::SameLine();
+				if (ImGui::Button("Reset")) {
+					LockStats::Reset();
+				}
+				ImGui::SameLine();
+				UICommon::HelpMarker("Acquisitions per lock site, sorted by the total time spent waiting for the lock. Only available in builds with instrumented locks.");
+
+				for (const auto& site : LockStats::GetStats()) {
+					ImGui::Text("[%s] %s", LockStats::GetLockTypeName(site.type).data(), site.name.data());
+					ImGui::Text("    acquired: %llu, contended: %llu, wait: %llu us (max %llu us), max hold: %llu us", site.acquireCount, site.contendedCount, site.totalWaitNanoseconds / 1000, site.maxWaitNanoseconds / 1000, site.maxHoldNanoseconds / 1000);
+				}
+
+				ImGui::TreePop();
+			}
+#endif
+
+			ImGui::Spacing();
+			ImGui::Separator();
+
 			// Animation queue progress bar settings
 			ImGui::AlignTextToFramePadding();
 			ImGui::TextUnformatted("Animation Queue Progress Bar Settings");
@@ -2086,6 +2301,108 @@ namespace UI
 		}
 	}
 
+	void UIMain::DrawProfiler()
+	{
+		auto& profiler = ConditionProfiler::GetSingleton();
+
+		bool bEnabled = ConditionProfiler::bEnabled;
+		if (ImGui::Checkbox("Enable profiler", &bEnabled)) {
+			ConditionProfiler::bEnabled = bEnabled;
+		}
+		ImGui::SameLine();
+		UICommon::HelpMarker("Enable to measure the time spent evaluating each condition type and the conditions of each submod. Times include nested conditions. Profiling adds a small cost to every evaluation, so only enable it while investigating. Not saved between sessions.");
+
+		ImGui::SameLine();
+		if (ImGui::Button("Reset")) {
+			profiler.Reset();
+		}
+
+		ImGui::SameLine();
+		if (ImGui::Button("Export to CSV")) {
+			if (auto path = logger::log_directory()) {
+				*path /= std::format("{}_Profile.csv"sv, Plugin::NAME);
+				if (profiler.ExportToCSV(*path)) {
+					logger::info("Exported condition profile to {}", path->string());
+				} else {
+					logger::error("Failed to export condition profile to {}", path->string());
+				}
+			}
+		}
+		ImGui::SameLine();
+		UICommon::HelpMarker("Writes the results to a CSV file in the SKSE log folder.");
+
+		ImGui::Spacing();
+		DrawProfilerTable("ProfilerConditions", "Condition", profiler.GetConditionStats());
+		ImGui::Spacing();
+		DrawProfilerTable("ProfilerSubMods", "Submod", profiler.GetSubModStats());
+	}
+
+	void UIMain::DrawProfilerTable(const char* a_tableId, const char* a_nameColumn, std::vector<ConditionProfiler::Stats> a_stats)
+	{
+		constexpr auto flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_Resizable | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_NoSavedSettings;
+		if (ImGui::BeginTable(a_tableId, 6, flags, ImVec2(0.f, ImGui::GetTextLineHeightWithSpacing() * 16))) {
+			ImGui::TableSetupScrollFreeze(0, 1);
+			ImGui::TableSetupColumn(a_nameColumn, ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 80.f);
+			ImGui::TableSetupColumn("True", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 60.f);
+			ImGui::TableSetupColumn("Total", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending, 80.f);
+			ImGui::TableSetupColumn("P50", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 70.f);
+			ImGui::TableSetupColumn("P99", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 70.f);
+			ImGui::TableHeadersRow();
+
+			const auto getTrueRatio = [](const ConditionProfiler::Stats& a_stats) {
+				return a_stats.calls > 0 ? static_cast<double>(a_stats.trueCount) / static_cast<double>(a_stats.calls) : 0.0;
+			};
+
+			if (const auto sortSpecs = ImGui::TableGetSortSpecs(); sortSpecs && sortSpecs->SpecsCount > 0) {
+				const auto& spec = sortSpecs->Specs[0];
+				const auto compare = [&](const ConditionProfiler::Stats& a_lhs, const ConditionProfiler::Stats& a_rhs) {
+					switch (spec.ColumnIndex) {
+					case 0:
+						return a_lhs.name < a_rhs.name;
+					case 1:
+						return a_lhs.calls < a_rhs.calls;
+					case 2:
+						return getTrueRatio(a_lhs) < getTrueRatio(a_rhs);
+					case 3:
+						return a_lhs.totalNanoseconds < a_rhs.totalNanoseconds;
+					case 4:
+						return a_lhs.p50Nanoseconds < a_rhs.p50Nanoseconds;
+					case 5:
+						return a_lhs.p99Nanoseconds < a_rhs.p99Nanoseconds;
+					default:
+						return false;
+					}
+				};
+				const bool bAscending = spec.SortDirection == ImGuiSortDirection_Ascending;
+				std::ranges::sort(a_stats, [&](const auto& a_lhs, const auto& a_rhs) { return bAscending ? compare(a_lhs, a_rhs) : compare(a_rhs, a_lhs); });
+			}
+
+			ImGuiListClipper clipper;
+			clipper.Begin(static_cast<int>(a_stats.size()));
+			while (clipper.Step()) {
+				for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+					const auto& stats = a_stats[i];
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(stats.name.data());
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(std::to_string(stats.calls).data());
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(std::format("{:.0f}%", getTrueRatio(stats) * 100.0).data());
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(std::format("{:.2f} ms", static_cast<double>(stats.totalNanoseconds) / 1000000.0).data());
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(std::format("{:.1f} us", static_cast<double>(stats.p50Nanoseconds) / 1000.0).data());
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(std::format("{:.1f} us", static_cast<double>(stats.p99Nanoseconds) / 1000.0).data());
+				}
+			}
+
+			ImGui::EndTable();
+		}
+	}
+
 	bool UIMain::DrawConditionSet(Conditions::ConditionSet* a_conditionSet, SubMod* a_parentSubMod, EditMode a_editMode, Conditions::ConditionType a_conditionType, RE::TESObjectREFR* a_refrToEvaluate, bool a_bDrawLines, const ImVec2& a_drawStartPos)
 	{
 		if (!a_conditionSet) {
@@ -2,6 +2,7 @@
 #include "UIComboFilter.h"
 #include "UIWindow.h"
 
+#include "ConditionProfiler.h"
 #include "OpenAnimationReplacer.h"
 #include <imgui_internal.h>
 
@@ -55,6 +56,8 @@ namespace UI
 		void DrawSubMod(ReplacerMod* a_replacerMod, SubMod* a_subMod, bool a_bAddPathToName = false);
 		void DrawReplacementAnimations();
 		void DrawReplacementAnimation(ReplacementAnimation* a_replacementAnimation);
+		void DrawProfiler();
+		static void DrawProfilerTable(const char* a_tableId, const char* a_nameColumn, std::vector<ConditionProfiler::Stats> a_stats);
 		bool DrawConditionSet(Conditions::ConditionSet* a_conditionSet, SubMod* a_parentSubMod, EditMode a_editMode, Conditions::ConditionType a_conditionType, RE::TESObjectREFR* a_refrToEvaluate, bool a_bDrawLines, const ImVec2& a_drawStartPos);
 		bool DrawFunctionSet(Functions::FunctionSet* a_functionSet, SubMod* a_parentSubMod, EditMode a_editMode, Functions::FunctionSetType a_functionSetType, RE::TESObjectREFR* a_refrToEvaluate, bool a_bDrawLines, const ImVec2& a_drawStartPos);
 		ImRect DrawCondition(std::unique_ptr<Conditions::ICondition>& a_condition, Conditions::ConditionSet* a_conditionSet, SubMod* a_parentSubMod, EditMode a_editMode, Conditions::ConditionType a_conditionType, RE::TESObjectREFR* a_refrToEvaluate, bool& a_bOutSetDirty);
@@ -5,6 +5,7 @@
 #include "UIAnimationLog.h"
 #include "UIAnimationQueue.h"
 #include "UIErrorBanner.h"
+#include "UIFrameStats.h"
 #include "UIMain.h"
 #include "UIWelcomeBanner.h"
 #include <dinput.h>
@@ -596,6 +597,7 @@ namespace UI
 			std::make_unique<UIAnimationLog>(),
 			std::make_unique<UIAnimationEventLog>(),
 			std::make_unique<UIAnimationQueue>(),
+			std::make_unique<UIFrameStats>(),
 			std::make_unique<UIErrorBanner>(),
 			std::make_unique<UIWelcomeBanner>()
 		} {}
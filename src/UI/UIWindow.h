@@ -10,6 +10,7 @@ namespace UI
 		kAnimationLog,
 		kAnimationEventLog,
 		kAnimationQueue,
+		kFrameStats,
 		kErrorBanner,
 		kWelcomeBanner,
 
@@ -355,6 +355,131 @@ namespace Utils
 		return false;
 	}
 
+	ConditionDependencies GetConditionDependencies(Conditions::ICondition* a_condition)
+	{
+		using Dependency = ConditionDependency;
+
+		// only conditions whose result is known to change exclusively through the tracked events are listed, everything else is re-evaluated every time
+		static const std::unordered_map<std::string, Dependency, CaseInsensitiveHash, CaseInsensitiveEqual> knownDependencies = {
+			// multi conditions evaluated on the same refr, dependencies of the child conditions are added below
+			{ "OR", Dependency::kNone },
+			{ "AND", Dependency::kNone },
+			{ "XOR", Dependency::kNone },
+
+			// static for the lifetime of a clip
+			{ "IsForm", Dependency::kNone },
+			{ "IsFemale", Dependency::kNone },
+			{ "IsChild", Dependency::kNone },
+			{ "IsActorBase", Dependency::kNone },
+			{ "IsRace", Dependency::kNone },
+			{ "IsUnique", Dependency::kNone },
+			{ "IsClass", Dependency::kNone },
+			{ "IsCombatStyle", Dependency::kNone },
+			{ "IsVoiceType", Dependency::kNone },
+			{ "HasRefType", Dependency::kNone },
+			{ "IsGuard", Dependency::kNone },
+			{ "IsSummoned", Dependency::kNone },
+
+			// TESEquipEvent
+			{ "IsEquipped", Dependency::kEquipment },
+			{ "IsEquippedType", Dependency::kEquipment },
+			{ "IsEquippedHasKeyword", Dependency::kEquipment },
+			{ "IsEquippedPower", Dependency::kEquipment },
+			{ "IsEquippedShout", Dependency::kEquipment },
+			{ "IsEquippedHasEnchantment", Dependency::kEquipment },
+			{ "IsEquippedHasEnchantmentWithKeyword", Dependency::kEquipment },
+			{ "IsWorn", Dependency::kEquipment },
+			{ "IsWornHasKeyword", Dependency::kEquipment },
+			{ "IsWornInSlot", Dependency::kEquipment },
+			{ "IsWornInSlotHasKeyword", Dependency::kEquipment },
+			{ "EquippedObjectWeight", Dependency::kEquipment },
+
+			// graph variables can be set without any animation graph event, so HasGraphVariable is left unknown
+
+			// BSAnimationGraphEvent
+			{ "IsWeaponDrawn", Dependency::kAnimationGraph },
+			{ "IsSneaking", Dependency::kAnimationGraph },
+			{ "IsSprinting", Dependency::kAnimationGraph },
+			{ "IsBlocking", Dependency::kAnimationGraph },
+			{ "IsAttacking", Dependency::kAnimationGraph },
+			{ "AttackState", Dependency::kAnimationGraph },
+
+			// TESCombatEvent
+			{ "IsInCombat", Dependency::kCombat },
+			{ "IsCombatState", Dependency::kCombat },
+
+			// in-game minute change
+			{ "CurrentGameTime", Dependency::kGameTime },
+
+			// TESActiveEffectApplyRemoveEvent
+			{ "HasMagicEffect", Dependency::kMagicEffects },
+			{ "HasMagicEffectWithKeyword", Dependency::kMagicEffects },
+		};
+
+		ConditionDependencies dependencies = Dependency::kNone;
+
+		if (a_condition->IsDisabled()) {
+			return dependencies;
+		}
+
+		if (a_condition->GetConditionType() == Conditions::ConditionType::kNormal) {
+			if (const auto search = knownDependencies.find(a_condition->GetName().data()); search != knownDependencies.end()) {
+				dependencies.set(search->second);
+			} else {
+				return Dependency::kUnknown;
+			}
+		} else if (a_condition->GetConditionType() != Conditions::ConditionType::kPreset) {
+			return Dependency::kUnknown;  // custom conditions from other plugins
+		}
+
+		for (uint32_t i = 0; i < a_condition->GetNumComponents(); ++i) {
+			if (const auto component = a_condition->GetComponent(i)) {
+				switch (component->GetType()) {
+				case Conditions::ConditionComponentType::kMulti:
+				case Conditions::ConditionComponentType::kPreset:
+					{
+						const auto multiComponent = static_cast<Conditions::IMultiConditionComponent*>(component);
+						dependencies.set(GetConditionSetDependencies(multiComponent->GetConditions()).get());
+						break;
+					}
+				case Conditions::ConditionComponentType::kNumeric:
+					{
+						// values read from actor values, graph variables or globals can change at any time
+						const auto numericComponent = static_cast<Conditions::NumericConditionComponent*>(component);
+						if (numericComponent->value.GetType() != Components::NumericValue::Type::kStaticValue) {
+							return Dependency::kUnknown;
+						}
+						break;
+					}
+				case Conditions::ConditionComponentType::kState:
+				case Conditions::ConditionComponentType::kCustom:
+					return Dependency::kUnknown;
+				default:
+					break;
+				}
+			}
+		}
+
+		return dependencies;
+	}
+
+	ConditionDependencies GetConditionSetDependencies(Conditions::ConditionSet* a_conditionSet)
+	{
+		ConditionDependencies dependencies = ConditionDependency::kNone;
+
+		if (a_conditionSet) {
+			a_conditionSet->ForEach([&](auto& a_childCondition) {
+				dependencies.set(GetConditionDependencies(a_childCondition.get()).get());
+				if (dependencies.all(ConditionDependency::kUnknown)) {
+					return RE::BSVisit::BSVisitControl::kStop;
+				}
+				return RE::BSVisit::BSVisitControl::kContinue;
+			});
+		}
+
+		return dependencies;
+	}
+
 	bool GetCurrentTarget(RE::Actor* a_actor, TargetType a_targetType, RE::TESObjectREFRPtr& a_outPtr)
 	{
 		if (a_actor) {
@@ -694,4 +819,95 @@ namespace Utils
 
 		return false;
 	}
+
+	float GetDistanceToCamera(const RE::TESObjectREFR* a_refr)
+	{
+		if (a_refr) {
+			if (const auto playerCamera = RE::PlayerCamera::GetSingleton()) {
+				if (const auto& cameraRoot = playerCamera->cameraRoot) {
+					return a_refr->GetPosition().GetDistance(cameraRoot->world.translate);
+				}
+			}
+		}
+
+		return 0.f;
+	}
+
+	InventoryItemInfo GetInventoryItemInfo(RE::TESObjectREFR* a_refr, RE::FormID a_formID)
+	{
+		InventoryItemInfo info;
+
+		if (!a_refr) {
+			return info;
+		}
+
+		bool bLeveled = false;
+		if (const auto inventoryChanges = a_refr->GetInventoryChanges(); inventoryChanges && inventoryChanges->entryList) {
+			for (const auto entry : *inventoryChanges->entryList) {
+				if (entry && entry->object && entry->object->GetFormID() == a_formID) {
+					info.count += entry->countDelta;
+					info.bWorn = info.bWorn || entry->IsWorn();
+					bLeveled = bLeveled || entry->IsLeveled();
+				}
+			}
+		}
+
+		// same as TESObjectREFR::GetInventory, base container counts are ignored for leveled entries
+		if (!bLeveled) {
+			if (const auto container = a_refr->GetContainer()) {
+				container->ForEachContainerObject([&](RE::ContainerObject& a_entry) {
+					if (a_entry.obj && a_entry.obj->GetFormID() == a_formID) {
+						info.count += a_entry.count;
+					}
+					return RE::BSContainer::ForEachResult::kContinue;
+				});
+			}
+		}
+
+		info.bWorn = info.bWorn && info.count > 0;
+
+		return info;
+	}
+
+	int32_t GetInventoryItemCount(RE::TESObjectREFR* a_refr, const std::function<bool(const RE::TESBoundObject&)>& a_filter)
+	{
+		int32_t count = 0;
+
+		if (!a_refr) {
+			return count;
+		}
+
+		const auto inventoryChanges = a_refr->GetInventoryChanges();
+		const bool bHasEntries = inventoryChanges && inventoryChanges->entryList;
+
+		if (bHasEntries) {
+			for (const auto entry : *inventoryChanges->entryList) {
+				if (entry && entry->object && a_filter(*entry->object)) {
+					count += entry->countDelta;
+				}
+			}
+		}
+
+		if (const auto container = a_refr->GetContainer()) {
+			const auto isLeveled = [&](const RE::TESBoundObject* a_object) {
+				if (bHasEntries) {
+					for (const auto entry : *inventoryChanges->entryList) {
+						if (entry && entry->object == a_object) {
+							return entry->IsLeveled();
+						}
+					}
+				}
+				return false;
+			};
+
+			container->ForEachContainerObject([&](RE::ContainerObject& a_entry) {
+				if (a_entry.obj && a_filter(*a_entry.obj) && !isLeveled(a_entry.obj)) {
+					count += a_entry.count;
+				}
+				return RE::BSContainer::ForEachResult::kContinue;
+			});
+		}
+
+		return count;
+	}
 }
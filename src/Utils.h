@@ -20,6 +20,53 @@ namespace Utils
 		kAnyTarget
 	};
 
+	// game state that a condition result depends on, used to skip re-evaluating interruptible clips when nothing relevant has changed
+	enum class ConditionDependency : uint32_t
+	{
+		kNone = 0,
+		kEquipment = 1 << 0,
+		kAnimationGraph = 1 << 1,
+		kCombat = 1 << 2,
+		kGameTime = 1 << 3,
+		kMagicEffects = 1 << 4,
+
+		kUnknown = 1u << 31,
+		kAll = 0xFFFFFFFF
+	};
+	using ConditionDependencies = SKSE::stl::enumeration<ConditionDependency, uint32_t>;
+
+	struct InventoryItemInfo
+	{
+		int32_t count = 0;
+		bool bWorn = false;
+	};
+
+	// identifies a refr in the per-actor caches without going through the handle manager, the form id catches a freed refr's address being reused
+	struct RefrKey
+	{
+		explicit RefrKey(const RE::TESObjectREFR* a_refr) :
+			refr(a_refr), formID(a_refr->GetFormID()) {}
+
+		bool operator==(const RefrKey&) const = default;
+
+		struct Hash
+		{
+			size_t operator()(const RefrKey& a_key) const
+			{
+				std::size_t seed = 0;
+				boost::hash_combine(seed, a_key.refr);
+				boost::hash_combine(seed, a_key.formID);
+				return seed;
+			}
+		};
+
+		// lets boost::hash_combine use it, e.g. as part of a KeyHash pair
+		friend size_t hash_value(const RefrKey& a_key) { return Hash{}(a_key); }
+
+		const RE::TESObjectREFR* refr;
+		RE::FormID formID;
+	};
+
 	[[nodiscard]] std::string_view TrimWhitespace(std::string_view a_s);
 	[[nodiscard]] std::string_view TrimQuotes(std::string_view a_s);
 	[[nodiscard]] std::string_view TrimSquareBrackets(std::string_view a_s);
@@ -134,6 +181,9 @@ namespace Utils
 
 	bool ConditionHasStateComponentWithSharedScope(Conditions::ICondition* a_condition);
 
+	[[nodiscard]] ConditionDependencies GetConditionDependencies(Conditions::ICondition* a_condition);
+	[[nodiscard]] ConditionDependencies GetConditionSetDependencies(Conditions::ConditionSet* a_conditionSet);
+
 	bool GetCurrentTarget(RE::Actor* a_actor, TargetType a_targetType, RE::TESObjectREFRPtr& a_outPtr);
 	bool GetTarget(RE::Actor* a_actor, RE::TESObjectREFRPtr& a_outPtr);
 	bool GetCombatTarget(RE::Actor* a_actor, RE::TESObjectREFRPtr& a_outPtr);
@@ -182,6 +232,12 @@ namespace Utils
 
 	[[nodiscard]] bool GetSurfaceNormal(RE::TESObjectREFR* a_refr, RE::hkVector4& a_outVector, bool a_bUseNavmesh);
 
+	[[nodiscard]] float GetDistanceToCamera(const RE::TESObjectREFR* a_refr);
+
+	// these walk the inventory directly instead of building the map returned by TESObjectREFR::GetInventory
+	[[nodiscard]] InventoryItemInfo GetInventoryItemInfo(RE::TESObjectREFR* a_refr, RE::FormID a_formID);
+	[[nodiscard]] int32_t GetInventoryItemCount(RE::TESObjectREFR* a_refr, const std::function<bool(const RE::TESBoundObject&)>& a_filter);
+
 	[[nodiscard]] inline RE::NiPoint3 TransformVectorByMatrix(const RE::NiPoint3& a_vector, const RE::NiMatrix3& a_matrix)
 	{
 		return RE::NiPoint3(a_matrix.entry[0][0] * a_vector.x + a_matrix.entry[0][1] * a_vector.y + a_matrix.entry[0][2] * a_vector.z,
@@ -1,4 +1,5 @@
 #include "Hooks.h"
+#include "InventoryCache.h"
 #include "OpenAnimationReplacer.h"
 #include "Settings.h"
 #include "UI/UIManager.h"
@@ -40,6 +41,11 @@ void MessageHandler(SKSE::MessagingInterface::Message* a_msg)
 			OpenAnimationReplacer::GetSingleton().InitFactories();
 		}
 		break;
+	case SKSE::MessagingInterface::kPreLoadGame:
+	case SKSE::MessagingInterface::kNewGame:
+		// handles are reused for different refrs after a load
+		InventoryCache::GetSingleton().Clear();
+		break;
 	}
 }
 
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace RE
+{
+	// same layout as the game's hkQsTransform: translation, rotation quaternion (x, y, z, w) and scale, each a 16 byte vector
+	struct hkQsTransform
+	{
+		float translation[4];
+		float rotation[4];
+		float scale[4];
+	};
+}
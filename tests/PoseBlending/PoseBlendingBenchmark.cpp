@@ -0,0 +1,81 @@
+#include "PoseBlending.h"
+#include "Reference.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// keeps the compiler from dropping the blends
+	volatile float sink = 0.f;
+
+	std::vector<RE::hkQsTransform> RandomPose(std::mt19937& a_rng, uint32_t a_numTracks)
+	{
+		std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+		std::vector<RE::hkQsTransform> pose(a_numTracks);
+		for (auto& transform : pose) {
+			float lengthSquared = 0.f;
+			for (int i = 0; i < 4; ++i) {
+				transform.translation[i] = unit(a_rng) * 100.f;
+				transform.rotation[i] = unit(a_rng);
+				transform.scale[i] = 1.f;
+				lengthSquared += transform.rotation[i] * transform.rotation[i];
+			}
+			const float length = std::sqrt(lengthSquared);
+			for (float& component : transform.rotation) {
+				component /= length;
+			}
+		}
+		return pose;
+	}
+
+	template <class Func>
+	double NanosecondsPerCall(uint32_t a_iterations, std::vector<RE::hkQsTransform>& a_out, Func&& a_func)
+	{
+		const auto start = Clock::now();
+		for (uint32_t i = 0; i < a_iterations; ++i) {
+			a_func();
+			sink = sink + a_out[i % a_out.size()].rotation[3];
+		}
+		const auto end = Clock::now();
+		return std::chrono::duration<double, std::nano>(end - start).count() / a_iterations;
+	}
+}
+
+// usage: PoseBlendingBenchmark [iterations]
+int main(int a_argc, char** a_argv)
+{
+	const uint32_t iterations = a_argc > 1 ? static_cast<uint32_t>(std::strtoul(a_argv[1], nullptr, 10)) : 100000;
+	if (iterations == 0) {
+		std::printf("usage: %s [iterations]\n", a_argv[0]);
+		return 1;
+	}
+
+	std::mt19937 rng(1);
+
+	std::printf("%8s %8s %16s %16s %8s\n", "bones", "layers", "per layer (ns)", "single pass (ns)", "speedup");
+	for (const uint32_t numTracks : { 100u, 200u, 300u }) {
+		for (const uint32_t numLayers : { 2u, 4u, 8u }) {
+			std::vector<std::vector<RE::hkQsTransform>> poses;
+			std::vector<PoseBlending::Layer> layers;
+			for (uint32_t i = 0; i < numLayers; ++i) {
+				poses.emplace_back(RandomPose(rng, numTracks));
+				layers.push_back({ poses.back().data(), numTracks, 1.f / (i + 1) });
+			}
+
+			std::vector<RE::hkQsTransform> out(numTracks);
+			const double perLayer = NanosecondsPerCall(iterations, out, [&] { Reference::BlendLayers(layers, out.data(), numTracks); });
+			const double singlePass = NanosecondsPerCall(iterations, out, [&] { PoseBlending::BlendLayers(layers, out.data(), numTracks); });
+
+			std::printf("%8u %8u %16.1f %16.1f %7.2fx\n", numTracks, numLayers, perLayer, singlePass, perLayer / singlePass);
+		}
+	}
+
+	return 0;
+}
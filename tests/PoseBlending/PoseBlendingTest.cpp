@@ -0,0 +1,191 @@
+#include "PoseBlending.h"
+#include "Reference.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr float tolerance = 1e-4f;
+
+	int failures = 0;
+
+	void Check(bool a_condition, const char* a_name)
+	{
+		if (!a_condition) {
+			std::printf("FAILED: %s\n", a_name);
+			++failures;
+		}
+	}
+
+	float MaxError(const std::vector<RE::hkQsTransform>& a_lhs, const std::vector<RE::hkQsTransform>& a_rhs, uint32_t a_numTracks)
+	{
+		float maxError = 0.f;
+		for (uint32_t track = 0; track < a_numTracks; ++track) {
+			for (int i = 0; i < 4; ++i) {
+				maxError = std::max({ maxError,
+					std::fabs(a_lhs[track].translation[i] - a_rhs[track].translation[i]),
+					std::fabs(a_lhs[track].rotation[i] - a_rhs[track].rotation[i]),
+					std::fabs(a_lhs[track].scale[i] - a_rhs[track].scale[i]) });
+			}
+		}
+		return maxError;
+	}
+
+	class PoseGenerator
+	{
+	public:
+		explicit PoseGenerator(uint32_t a_seed) :
+			_rng(a_seed) {}
+
+		std::vector<RE::hkQsTransform> Pose(uint32_t a_numTracks)
+		{
+			std::vector<RE::hkQsTransform> pose(a_numTracks);
+			for (auto& transform : pose) {
+				float lengthSquared = 0.f;
+				for (int i = 0; i < 4; ++i) {
+					transform.translation[i] = _unit(_rng) * 100.f;
+					transform.rotation[i] = _unit(_rng);
+					transform.scale[i] = 1.f + _unit(_rng) * 0.5f;
+					lengthSquared += transform.rotation[i] * transform.rotation[i];
+				}
+				const float length = std::sqrt(lengthSquared);
+				for (float& component : transform.rotation) {
+					component /= length;
+				}
+			}
+			return pose;
+		}
+
+		float Amount() { return (_unit(_rng) + 1.f) * 0.5f; }
+		uint32_t Range(uint32_t a_min, uint32_t a_max) { return std::uniform_int_distribution<uint32_t>(a_min, a_max)(_rng); }
+
+	private:
+		std::mt19937 _rng;
+		std::uniform_real_distribution<float> _unit{ -1.f, 1.f };
+	};
+
+	// random layer counts and amounts, layers with fewer or more tracks than the first one, and outputs shorter or longer than the pose
+	void TestMatchesReference()
+	{
+		PoseGenerator generator(1);
+		float maxError = 0.f;
+
+		for (uint32_t iteration = 0; iteration < 2000; ++iteration) {
+			const uint32_t numTracks = generator.Range(1, 300);
+			const uint32_t numLayers = generator.Range(1, 6);
+
+			std::vector<std::vector<RE::hkQsTransform>> poses;
+			std::vector<PoseBlending::Layer> layers;
+			for (uint32_t i = 0; i < numLayers; ++i) {
+				const uint32_t layerTracks = i == 0 ? numTracks : generator.Range(1, numTracks + 10);
+				poses.emplace_back(generator.Pose(layerTracks));
+				layers.push_back({ poses.back().data(), layerTracks, generator.Amount() });
+			}
+
+			const uint32_t numOutTracks = iteration % 3 == 0 ? generator.Range(1, numTracks) : numTracks + 5;
+			std::vector<RE::hkQsTransform> expected(numOutTracks);
+			std::vector<RE::hkQsTransform> result(numOutTracks);
+			Reference::BlendLayers(layers, expected.data(), numOutTracks);
+			PoseBlending::BlendLayers(layers, result.data(), numOutTracks);
+
+			maxError = std::max(maxError, MaxError(result, expected, std::min(numTracks, numOutTracks)));
+		}
+
+		std::printf("matches reference: max error %g\n", maxError);
+		Check(maxError < tolerance, "single pass blend matches the layer by layer reference");
+	}
+
+	// the layer rotation is in the opposite hemisphere of the accumulated one, so the blend has to flip it to take the short path
+	void TestHemisphereFlip()
+	{
+		RE::hkQsTransform base{ { 0.f, 0.f, 0.f, 0.f }, { 0.f, 0.f, 0.f, 1.f }, { 1.f, 1.f, 1.f, 0.f } };
+		RE::hkQsTransform flipped{ { 0.f, 0.f, 0.f, 0.f }, { 0.f, 0.f, 0.f, -1.f }, { 1.f, 1.f, 1.f, 0.f } };
+
+		const std::vector<PoseBlending::Layer> layers{ { &base, 1, 0.f }, { &flipped, 1, 0.5f } };
+		RE::hkQsTransform result{};
+		PoseBlending::BlendLayers(layers, &result, 1);
+
+		// without the flip the rotations would cancel out and normalizing would divide by zero
+		Check(std::isfinite(result.rotation[3]) && std::fabs(std::fabs(result.rotation[3]) - 1.f) < tolerance, "opposite hemisphere rotations blend to the same orientation");
+
+		PoseGenerator generator(2);
+		std::vector<RE::hkQsTransform> first = generator.Pose(64);
+		std::vector<RE::hkQsTransform> second = first;
+		for (auto& transform : second) {
+			for (float& component : transform.rotation) {
+				component = -component;
+			}
+		}
+
+		const std::vector<PoseBlending::Layer> poseLayers{ { first.data(), 64, 0.f }, { second.data(), 64, 0.3f } };
+		std::vector<RE::hkQsTransform> expected(64);
+		std::vector<RE::hkQsTransform> blended(64);
+		Reference::BlendLayers(poseLayers, expected.data(), 64);
+		PoseBlending::BlendLayers(poseLayers, blended.data(), 64);
+		Check(MaxError(blended, expected, 64) < tolerance, "negated quaternions match the reference");
+	}
+
+	// the output pose is usually also the first layer
+	void TestAliasing()
+	{
+		PoseGenerator generator(3);
+		std::vector<RE::hkQsTransform> pose = generator.Pose(200);
+		const std::vector<RE::hkQsTransform> other = generator.Pose(150);
+		const std::vector<RE::hkQsTransform> original = pose;
+
+		const std::vector<PoseBlending::Layer> expectedLayers{ { original.data(), 200, 0.f }, { other.data(), 150, 0.25f } };
+		std::vector<RE::hkQsTransform> expected(200);
+		Reference::BlendLayers(expectedLayers, expected.data(), 200);
+
+		const std::vector<PoseBlending::Layer> layers{ { pose.data(), 200, 0.f }, { other.data(), 150, 0.25f } };
+		PoseBlending::BlendLayers(layers, pose.data(), 200);
+		Check(MaxError(pose, expected, 200) < tolerance, "output aliasing the first layer");
+	}
+
+	void TestEdgeCases()
+	{
+		PoseGenerator generator(4);
+		const std::vector<RE::hkQsTransform> pose = generator.Pose(10);
+
+		// no layers leaves the output alone
+		std::vector<RE::hkQsTransform> untouched = generator.Pose(10);
+		const std::vector<RE::hkQsTransform> untouchedCopy = untouched;
+		PoseBlending::BlendLayers({}, untouched.data(), 10);
+		Check(MaxError(untouched, untouchedCopy, 10) == 0.f, "no layers");
+
+		// a single layer is copied as is
+		std::vector<RE::hkQsTransform> copied(10);
+		const std::vector<PoseBlending::Layer> single{ { pose.data(), 10, 0.7f } };
+		PoseBlending::BlendLayers(single, copied.data(), 10);
+		Check(MaxError(copied, pose, 10) == 0.f, "single layer");
+
+		// tracks past the first layer are not written
+		std::vector<RE::hkQsTransform> longer = generator.Pose(20);
+		const std::vector<RE::hkQsTransform> longerCopy = longer;
+		PoseBlending::BlendLayers(single, longer.data(), 20);
+		bool bTailUntouched = true;
+		for (uint32_t track = 10; track < 20; ++track) {
+			bTailUntouched &= std::memcmp(&longer[track], &longerCopy[track], sizeof(RE::hkQsTransform)) == 0;
+		}
+		Check(bTailUntouched, "tracks past the first layer");
+	}
+}
+
+int main()
+{
+	TestMatchesReference();
+	TestHemisphereFlip();
+	TestAliasing();
+	TestEdgeCases();
+
+	if (failures > 0) {
+		std::printf("%d check(s) failed\n", failures);
+		return 1;
+	}
+
+	std::printf("all checks passed\n");
+	return 0;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cmath>
+
+namespace Reference
+{
+	// scalar version of a single hkbBlendPoses track: from * (1 - amount) + to * amount, with the rotation nlerped in the same hemisphere
+	inline RE::hkQsTransform Blend(const RE::hkQsTransform& a_from, const RE::hkQsTransform& a_to, float a_amount)
+	{
+		float dot = 0.f;
+		for (int i = 0; i < 4; ++i) {
+			dot += a_from.rotation[i] * a_to.rotation[i];
+		}
+		const float sign = dot < 0.f ? -1.f : 1.f;
+
+		RE::hkQsTransform result{};
+		float lengthSquared = 0.f;
+		for (int i = 0; i < 4; ++i) {
+			result.translation[i] = a_from.translation[i] * (1.f - a_amount) + a_to.translation[i] * a_amount;
+			result.rotation[i] = a_from.rotation[i] * (1.f - a_amount) + sign * a_to.rotation[i] * a_amount;
+			result.scale[i] = a_from.scale[i] * (1.f - a_amount) + a_to.scale[i] * a_amount;
+			lengthSquared += result.rotation[i] * result.rotation[i];
+		}
+
+		const float length = std::sqrt(lengthSquared);
+		for (float& component : result.rotation) {
+			component /= length;
+		}
+
+		return result;
+	}
+
+	// blends the layers one after another like the game does, one pass over the pose per layer
+	inline void BlendLayers(std::span<const PoseBlending::Layer> a_layers, RE::hkQsTransform* a_out, uint32_t a_numOutTracks)
+	{
+		if (a_layers.empty()) {
+			return;
+		}
+
+		const uint32_t numTracks = std::min(a_layers.front().numTracks, a_numOutTracks);
+		if (a_layers.front().tracks != a_out) {
+			std::copy_n(a_layers.front().tracks, numTracks, a_out);
+		}
+
+		for (const auto& layer : a_layers.subspan(1)) {
+			const uint32_t layerTracks = std::min(layer.numTracks, numTracks);
+			for (uint32_t track = 0; track < layerTracks; ++track) {
+				a_out[track] = Blend(layer.tracks[track], a_out[track], layer.amount);
+			}
+		}
+	}
+}